@@ -13,8 +13,14 @@
 #define KERBAL_ALGORITHM_HEAP_HPP
 
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <functional>
 
 namespace kerbal
 {
@@ -217,6 +223,157 @@ namespace kerbal
 				kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp, kerbal::iterator::iterator_category(first));
 			}
 
+			/*
+			 * d-ary heap on random access iterators: the children of the node i are D * i + 1, ..., D * i + D.
+			 * The sifts move a hole instead of swapping, so that each step costs one move.
+			 */
+
+			template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void d_ary_heap_sift_up(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type i,
+									Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type D = static_cast<difference_type>(ARITY);
+
+				if (i == 0) {
+					return;
+				}
+				difference_type parent = (i - 1) / D;
+				if (!cmp(first[parent], first[i])) {
+					return;
+				}
+				value_type tmp(kerbal::compatibility::to_xvalue(first[i]));
+				do {
+					first[i] = kerbal::compatibility::to_xvalue(first[parent]);
+					i = parent;
+					if (i == 0) {
+						break;
+					}
+					parent = (i - 1) / D;
+				} while (cmp(first[parent], tmp));
+				first[i] = kerbal::compatibility::to_xvalue(tmp);
+			}
+
+			template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void d_ary_heap_sift_down(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type i,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+									Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type D = static_cast<difference_type>(ARITY);
+
+				difference_type child = D * i + 1;
+				if (child >= len) {
+					return;
+				}
+				value_type tmp(kerbal::compatibility::to_xvalue(first[i]));
+				do {
+					difference_type child_last = len - child < D ? len : child + D;
+					difference_type max_one = child;
+					for (++child; child < child_last; ++child) {
+						if (cmp(first[max_one], first[child])) {
+							max_one = child;
+						}
+					}
+					if (!cmp(tmp, first[max_one])) {
+						break;
+					}
+					first[i] = kerbal::compatibility::to_xvalue(first[max_one]);
+					i = max_one;
+					child = D * i + 1;
+				} while (child < len);
+				first[i] = kerbal::compatibility::to_xvalue(tmp);
+			}
+
+			/*
+			 * Move the top of the heap [first, first + len + 1) to first[len] and restore the heap [first, first + len).
+			 * The hole is moved down to a leaf along the larger children without comparing with the element,
+			 * which is likely to go back to the bottom anyway, then the element is sifted up from there.
+			 * It saves about half of the comparisons for sort_heap, whose elements come from random leaves, but not
+			 * for pop_heap of a priority queue, whose back is often close to the top.
+			 */
+			template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void d_ary_heap_pop_fill(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+									Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type D = static_cast<difference_type>(ARITY);
+
+				value_type tmp(kerbal::compatibility::to_xvalue(first[len]));
+				first[len] = kerbal::compatibility::to_xvalue(first[0]);
+				difference_type i = 0;
+				difference_type child = 1;
+				while (child < len) {
+					difference_type child_last = len - child < D ? len : child + D;
+					difference_type max_one = child;
+					for (++child; child < child_last; ++child) {
+						max_one = cmp(first[max_one], first[child]) ? child : max_one;
+					}
+					first[i] = kerbal::compatibility::to_xvalue(first[max_one]);
+					i = max_one;
+					child = D * i + 1;
+				}
+				while (i > 0) {
+					difference_type parent = (i - 1) / D;
+					if (!cmp(first[parent], tmp)) {
+						break;
+					}
+					first[i] = kerbal::compatibility::to_xvalue(first[parent]);
+					i = parent;
+				}
+				first[i] = kerbal::compatibility::to_xvalue(tmp);
+			}
+
+			/*
+			 * Restore the heap property of [first, first + len), of which [first, first + mid) is a heap.
+			 * Only the ancestors of the appended elements are sifted down, level by level from the bottom,
+			 * which is O(len - mid + log(len) ^ 2). When mid == 0, it is Floyd's O(n) heapify.
+			 */
+			template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void d_ary_heapify(RandomAccessIterator first,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type mid,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+								Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type D = static_cast<difference_type>(ARITY);
+
+				if (len < 2 || mid == len) {
+					return;
+				}
+				difference_type hi = (len - 2) / D;
+				difference_type lo = mid == 0 ? 0 : (mid - 1) / D;
+				while (true) {
+					for (difference_type i = hi; i >= lo; --i) {
+						detail::d_ary_heap_sift_down(first, i, len, cmp, arity);
+					}
+					if (lo == 0) {
+						break;
+					}
+					// the nodes not less than lo are done
+					hi = (hi - 1) / D < lo - 1 ? (hi - 1) / D : lo - 1;
+					lo = (lo - 1) / D;
+				}
+			}
+
 		} // namespace detail
 
 		template <typename BidirectionalIterator, typename Compare>
@@ -349,27 +506,251 @@ namespace kerbal
 			return kerbal::algorithm::is_heap(first, last, std::less<value_type>());
 		}
 
+		namespace detail
+		{
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void make_heap(BidirectionalIterator first, BidirectionalIterator last, Compare & cmp,
+							std::bidirectional_iterator_tag)
+			{
+				typedef BidirectionalIterator iterator;
+
+				iterator current_adjust(first);
+				while (current_adjust != last) {
+					kerbal::algorithm::push_heap(first, current_adjust, cmp);
+					++current_adjust;
+				}
+				kerbal::algorithm::push_heap(first, last, cmp);
+			}
+
+			/*
+			 * Floyd's bottom-up heapify, O(n)
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+							std::random_access_iterator_tag)
+			{
+				kerbal::algorithm::detail::d_ary_heapify(first, 0, kerbal::iterator::distance(first, last), cmp,
+														kerbal::type_traits::integral_constant<size_t, 2>());
+			}
+
+		} // namespace detail
+
 		template <typename BidirectionalIterator, typename Compare>
 		KERBAL_CONSTEXPR14
 		void make_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
+		{
+			kerbal::algorithm::detail::make_heap(first, last, cmp, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void make_heap(BidirectionalIterator first, BidirectionalIterator last)
 		{
 			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::make_heap(first, last, std::less<value_type>());
+		}
+
+		/*
+		 * The heap algorithms with an arity tag work on a D-ary heap, a node of which has D children laid out
+		 * next to each other, so that the children of a node share one cache line for 4-ary and 8-ary heaps
+		 * of small elements. The binary heap (D == 2) ones are the same as the ones without the tag.
+		 * A heap built by the ones of one arity must be accessed by the ones of the same arity.
+		 */
 
-			iterator current_adjust(first);
-			while (current_adjust != last) {
-				kerbal::algorithm::push_heap(first, current_adjust, cmp);
-				++current_adjust;
+		template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			if (first == last) {
+				return;
 			}
+			kerbal::algorithm::detail::d_ary_heap_sift_up(first, kerbal::iterator::distance(first, last) - 1, cmp, arity);
+		}
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void push_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, 2>)
+		{
 			kerbal::algorithm::push_heap(first, last, cmp);
 		}
 
+		template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			if (first != last) {
+				--last;
+				if (first != last) {
+					kerbal::algorithm::iter_swap(first, last);
+					kerbal::algorithm::detail::d_ary_heap_sift_down(first, 0, kerbal::iterator::distance(first, last), cmp, arity);
+				}
+			}
+		}
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void pop_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, 2>)
+		{
+			kerbal::algorithm::pop_heap(first, last, cmp);
+		}
+
+		template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			while (len > 1) {
+				--len;
+				kerbal::algorithm::detail::d_ary_heap_pop_fill(first, len, cmp, arity);
+			}
+		}
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void sort_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, 2>)
+		{
+			kerbal::algorithm::sort_heap(first, last, cmp);
+		}
+
+		template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator
+		is_heap_until(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY>)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			const difference_type D = static_cast<difference_type>(ARITY);
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			for (difference_type i = 1; i < len; ++i) {
+				if (cmp(first[(i - 1) / D], first[i])) {
+					return first + i;
+				}
+			}
+			return last;
+		}
+
+		template <typename ForwardIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		is_heap_until(ForwardIterator first, ForwardIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, 2>)
+		{
+			return kerbal::algorithm::is_heap_until(first, last, cmp);
+		}
+
+		template <typename ForwardIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		bool is_heap(ForwardIterator first, ForwardIterator last, Compare cmp,
+					kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			return kerbal::algorithm::is_heap_until(first, last, cmp, arity) == last;
+		}
+
+		template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			kerbal::algorithm::detail::d_ary_heapify(first, 0, kerbal::iterator::distance(first, last), cmp, arity);
+		}
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void make_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, 2>)
+		{
+			kerbal::algorithm::make_heap(first, last, cmp);
+		}
+
+		namespace detail
+		{
+
+			template <typename BidirectionalIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void push_heap(BidirectionalIterator first, BidirectionalIterator mid, BidirectionalIterator last,
+							Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY> arity,
+							std::bidirectional_iterator_tag)
+			{
+				while (mid != last) {
+					++mid;
+					kerbal::algorithm::push_heap(first, mid, cmp, arity);
+				}
+			}
+
+			template <typename RandomAccessIterator, typename Compare, size_t ARITY>
+			KERBAL_CONSTEXPR14
+			void push_heap(RandomAccessIterator first, RandomAccessIterator mid, RandomAccessIterator last,
+							Compare & cmp, kerbal::type_traits::integral_constant<size_t, ARITY> arity,
+							std::random_access_iterator_tag)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type D = static_cast<difference_type>(ARITY);
+
+				difference_type m(kerbal::iterator::distance(first, mid));
+				difference_type len(kerbal::iterator::distance(first, last));
+
+				// a few elements are pushed one by one, which is O(1) on average for each
+				difference_type height = 0;
+				for (difference_type n = len; n > 0; n /= D) {
+					++height;
+				}
+				if (len - m <= height) {
+					for (difference_type i = m; i < len; ++i) {
+						detail::d_ary_heap_sift_up(first, i, cmp, arity);
+					}
+					return;
+				}
+				detail::d_ary_heapify(first, m, len, cmp, arity);
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Push all the elements of [mid, last) to the heap [first, mid), so that [first, last) becomes a heap.
+		 *
+		 * Many elements are heapified together in O(last - mid + log(last - first) ^ 2), instead of
+		 * O((last - mid) * log(last - first)) by pushing them one by one.
+		 */
+		template <typename BidirectionalIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void push_heap(BidirectionalIterator first, BidirectionalIterator mid, BidirectionalIterator last, Compare cmp,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			kerbal::algorithm::detail::push_heap(first, mid, last, cmp, arity, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void push_heap(BidirectionalIterator first, BidirectionalIterator mid, BidirectionalIterator last, Compare cmp)
+		{
+			kerbal::algorithm::push_heap(first, mid, last, cmp, kerbal::type_traits::integral_constant<size_t, 2>());
+		}
+
 		template <typename BidirectionalIterator>
 		KERBAL_CONSTEXPR14
-		void make_heap(BidirectionalIterator first, BidirectionalIterator last)
+		void push_heap(BidirectionalIterator first, BidirectionalIterator mid, BidirectionalIterator last)
 		{
 			typedef BidirectionalIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
-			kerbal::algorithm::make_heap(first, last, std::less<value_type>());
+			kerbal::algorithm::push_heap(first, mid, last, std::less<value_type>());
 		}
 
 	} // namespace algorithm
@@ -0,0 +1,211 @@
+/**
+ * @file       k_way_merge.hpp
+ * @brief
+ * @date       2020-09-02
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_K_WAY_MERGE_HPP
+#define KERBAL_ALGORITHM_K_WAY_MERGE_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Whether run a should be output before run b. An exhausted run loses to any run.
+			 * The stable version breaks ties by the index of the runs, so that the equivalent elements
+			 * are output in the order of the runs they come from.
+			 */
+			template <typename InputIterator, typename Compare>
+			bool k_way_merge_beats(const std::vector<InputIterator> & cur, const std::vector<InputIterator> & end,
+									size_t a, size_t b, Compare & cmp, kerbal::type_traits::false_type /*stable*/)
+			{
+				if (cur[a] == end[a]) {
+					return false;
+				}
+				if (cur[b] == end[b]) {
+					return true;
+				}
+				return !cmp(*cur[b], *cur[a]);
+			}
+
+			template <typename InputIterator, typename Compare>
+			bool k_way_merge_beats(const std::vector<InputIterator> & cur, const std::vector<InputIterator> & end,
+									size_t a, size_t b, Compare & cmp, kerbal::type_traits::true_type /*stable*/)
+			{
+				if (cur[a] == end[a]) {
+					return false;
+				}
+				if (cur[b] == end[b]) {
+					return true;
+				}
+				if (a < b) {
+					return !cmp(*cur[b], *cur[a]);
+				} else {
+					return cmp(*cur[a], *cur[b]);
+				}
+			}
+
+			/*
+			 * Loser tree: the runs are the leaves k, k + 1, ..., 2k - 1, each internal node 1, 2, ..., k - 1
+			 * keeps the loser of the match between the winners of its two subtrees and tree[0] keeps the
+			 * overall winner. After the winner is advanced, only the matches on the path from its leaf to the
+			 * root are replayed, which is lg(k) comparisons per output element.
+			 */
+			template <typename ForwardIterator, typename OutputIterator, typename Compare, typename Stable>
+			OutputIterator
+			k_way_merge(ForwardIterator ranges_first, ForwardIterator ranges_last,
+						OutputIterator to, Compare & cmp, Stable stable)
+			{
+				typedef ForwardIterator range_iterator;
+				typedef typename kerbal::iterator::iterator_traits<range_iterator>::value_type range_type;
+				typedef typename range_type::first_type iterator;
+
+				std::vector<iterator> cur;
+				std::vector<iterator> end;
+				while (ranges_first != ranges_last) {
+					const range_type & range = *ranges_first;
+					if (range.first != range.second) { // empty runs never take part in the matches
+						cur.push_back(range.first);
+						end.push_back(range.second);
+					}
+					++ranges_first;
+				}
+
+				size_t k = cur.size();
+				if (k == 0) {
+					return to;
+				}
+				if (k == 1) {
+					return kerbal::algorithm::copy(cur[0], end[0], to);
+				}
+
+				std::vector<size_t> tree(k);
+				{
+					std::vector<size_t> winner(k);
+					for (size_t t = k - 1; t > 0; --t) {
+						size_t l = 2 * t >= k ? 2 * t - k : winner[2 * t];
+						size_t r = 2 * t + 1 >= k ? 2 * t + 1 - k : winner[2 * t + 1];
+						if (detail::k_way_merge_beats(cur, end, l, r, cmp, stable)) {
+							winner[t] = l;
+							tree[t] = r;
+						} else {
+							winner[t] = r;
+							tree[t] = l;
+						}
+					}
+					tree[0] = winner[1];
+				}
+
+				size_t alive = k;
+				while (true) {
+					size_t w = tree[0];
+					kerbal::operators::generic_assign(*to, *cur[w]); // *to = *cur[w];
+					++to;
+					++cur[w];
+					if (cur[w] == end[w]) {
+						--alive;
+						if (alive == 1) {
+							break;
+						}
+					}
+					for (size_t t = (w + k) / 2; t > 0; t /= 2) {
+						if (detail::k_way_merge_beats(cur, end, tree[t], w, cmp, stable)) {
+							size_t loser = w;
+							w = tree[t];
+							tree[t] = loser;
+						}
+					}
+					tree[0] = w;
+				}
+
+				// only one run is left, no more matches are needed
+				for (size_t i = 0; i < k; ++i) {
+					if (cur[i] != end[i]) {
+						return kerbal::algorithm::copy(cur[i], end[i], to);
+					}
+				}
+				return to;
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Merge several sorted runs into one sorted sequence in a single pass.
+		 *
+		 * [ranges_first, ranges_last) is a range of pairs of iterators (e.g. std::pair<Iterator, Iterator>), each of
+		 * which is a sorted run [first, second). O(n log k) comparisons, every element is copied exactly once.
+		 * Not stable, see stable_k_way_merge.
+		 *
+		 * To merge several flat_ordered containers, pass the pairs of their cbegin() and cend() with value_comp()
+		 * of any of them.
+		 *
+		 * @return the end of the output sequence
+		 */
+		template <typename ForwardIterator, typename OutputIterator, typename Compare>
+		OutputIterator
+		k_way_merge(ForwardIterator ranges_first, ForwardIterator ranges_last, OutputIterator to, Compare cmp)
+		{
+			return kerbal::algorithm::detail::k_way_merge(ranges_first, ranges_last, to, cmp,
+															kerbal::type_traits::false_type());
+		}
+
+		template <typename ForwardIterator, typename OutputIterator>
+		OutputIterator
+		k_way_merge(ForwardIterator ranges_first, ForwardIterator ranges_last, OutputIterator to)
+		{
+			typedef ForwardIterator range_iterator;
+			typedef typename kerbal::iterator::iterator_traits<range_iterator>::value_type range_type;
+			typedef typename range_type::first_type iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::k_way_merge(ranges_first, ranges_last, to, std::less<value_type>());
+		}
+
+		/**
+		 * @brief Same as k_way_merge, but the equivalent elements are output in the order of the runs they come from,
+		 *        and in their original order within a run.
+		 */
+		template <typename ForwardIterator, typename OutputIterator, typename Compare>
+		OutputIterator
+		stable_k_way_merge(ForwardIterator ranges_first, ForwardIterator ranges_last, OutputIterator to, Compare cmp)
+		{
+			return kerbal::algorithm::detail::k_way_merge(ranges_first, ranges_last, to, cmp,
+															kerbal::type_traits::true_type());
+		}
+
+		template <typename ForwardIterator, typename OutputIterator>
+		OutputIterator
+		stable_k_way_merge(ForwardIterator ranges_first, ForwardIterator ranges_last, OutputIterator to)
+		{
+			typedef ForwardIterator range_iterator;
+			typedef typename kerbal::iterator::iterator_traits<range_iterator>::value_type range_type;
+			typedef typename range_type::first_type iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::stable_k_way_merge(ranges_first, ranges_last, to, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_K_WAY_MERGE_HPP
@@ -12,12 +12,18 @@
 #ifndef KERBAL_ALGORITHM_SORT_HPP
 #define KERBAL_ALGORITHM_SORT_HPP
 
+#include <kerbal/algorithm/sort/adaptive_sort.hpp>
+#include <kerbal/algorithm/sort/argsort.hpp>
 #include <kerbal/algorithm/sort/bubble_sort.hpp>
+#include <kerbal/algorithm/sort/compare_by_key.hpp>
 #include <kerbal/algorithm/sort/heap_sort.hpp>
 #include <kerbal/algorithm/sort/insertion_sort.hpp>
 #include <kerbal/algorithm/sort/intro_sort.hpp>
 #include <kerbal/algorithm/sort/is_sorted.hpp>
 #include <kerbal/algorithm/sort/merge_sort.hpp>
+#include <kerbal/algorithm/sort/msd_radix_sort.hpp>
+#include <kerbal/algorithm/sort/nth_element.hpp>
+#include <kerbal/algorithm/sort/partial_sort.hpp>
 #include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
 #include <kerbal/algorithm/sort/quick_sort.hpp>
 #include <kerbal/algorithm/sort/radix_sort.hpp>
@@ -25,5 +31,6 @@
 #include <kerbal/algorithm/sort/shell_sort.hpp>
 #include <kerbal/algorithm/sort/sort.hpp>
 #include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/algorithm/sort/tim_sort.hpp>
 
 #endif // KERBAL_ALGORITHM_SORT_HPP
@@ -0,0 +1,380 @@
+/**
+ * @file       adaptive_sort.hpp
+ * @brief
+ * @date       2020-09-06
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_ADAPTIVE_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_ADAPTIVE_SORT_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/querier.hpp>
+#include <kerbal/algorithm/sort/is_sorted.hpp>
+#include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
+#include <kerbal/algorithm/sort/sort.hpp>
+#include <kerbal/algorithm/sort/tim_sort.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		struct adaptive_sort_decision
+		{
+				enum type
+				{
+					ALREADY_SORTED,
+					REVERSE,
+					MERGE_RUNS,
+					COUNTING_SORT,
+					PIGEONHOLE_SORT,
+					RADIX_SORT,
+					INTRO_SORT
+				};
+		};
+
+		/**
+		 * @brief What adaptive_sort has measured and decided.
+		 */
+		struct adaptive_sort_stats
+		{
+				/// number of the elements
+				size_t length;
+
+				/// number of the sampled adjacent pairs, and how many of them are in ascending or descending order
+				size_t samples;
+				size_t ascents;
+				size_t descents;
+
+				/// number of the monotonic runs, 0 if not counted. The counting stops at the first run over the limit.
+				size_t runs;
+
+				/// max - min of the keys, 0 if not measured
+				unsigned long long key_span;
+
+				adaptive_sort_decision::type decision;
+
+				adaptive_sort_stats() KERBAL_NOEXCEPT :
+						length(0), samples(0), ascents(0), descents(0), runs(0), key_span(0),
+						decision(adaptive_sort_decision::INTRO_SORT)
+				{
+				}
+		};
+
+		struct adaptive_sort_ignore_stats
+		{
+				void operator()(const adaptive_sort_stats &) const KERBAL_NOEXCEPT
+				{
+				}
+		};
+
+		namespace detail
+		{
+
+			template <typename RandomAccessIterator>
+			struct adaptive_sort_sample_num:
+					kerbal::type_traits::integral_constant<size_t, 64>
+			{
+			};
+
+			/*
+			 * the runs are merged only if they are 256 elements long on average
+			 */
+			inline
+			size_t adaptive_sort_max_runs(size_t len) KERBAL_NOEXCEPT
+			{
+				return len / 256 + 1;
+			}
+
+			/*
+			 * Compare the adjacent pairs at evenly spaced positions.
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			void adaptive_sort_sample(RandomAccessIterator first, size_t len, Compare & cmp, adaptive_sort_stats & stats)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const size_t samples = len - 1 < adaptive_sort_sample_num<iterator>::value ?
+										len - 1 : adaptive_sort_sample_num<iterator>::value;
+				stats.samples = samples;
+				for (size_t s = 0; s < samples; ++s) {
+					iterator it(first + static_cast<difference_type>(s * (len - 1) / samples));
+					if (cmp(*(it + 1), *it)) {
+						++stats.descents;
+					} else if (cmp(*it, *(it + 1))) {
+						++stats.ascents;
+					}
+				}
+			}
+
+			/*
+			 * Count the runs in the same way as tim_sort: non-descending or strictly descending.
+			 * @return the number of the runs, or limit + 1 once it is exceeded
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			size_t adaptive_sort_count_runs(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+											size_t limit)
+			{
+				typedef RandomAccessIterator iterator;
+
+				size_t runs = 0;
+				while (first != last) {
+					++runs;
+					if (runs > limit) {
+						break;
+					}
+					iterator run_last(first + 1);
+					if (run_last == last) {
+						break;
+					}
+					if (cmp(*run_last, *first)) {
+						++run_last;
+						while (run_last != last && cmp(*run_last, *(run_last - 1))) {
+							++run_last;
+						}
+					} else {
+						++run_last;
+						while (run_last != last && !cmp(*run_last, *(run_last - 1))) {
+							++run_last;
+						}
+					}
+					first = run_last;
+				}
+				return runs;
+			}
+
+			/*
+			 * Counting sort over [min, min + span] is applicable if the elements are integers compared by
+			 * std::less or std::greater, except those pigeonhole sort has been used for.
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			struct adaptive_sort_counting_sort_policy_helper
+			{
+					typedef RandomAccessIterator iterator;
+					typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+					typedef sort_overload_policy_helper<iterator, Compare> serial_policy_helper;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::type_traits::is_integral<value_type>::value &&
+							sizeof(value_type) <= sizeof(unsigned long long) &&
+							!serial_policy_helper::IS_PIGEONHOLE_SORT_ASC::value &&
+							!serial_policy_helper::IS_PIGEONHOLE_SORT_DESC::value &&
+							(
+								serial_policy_helper::IS_RADIX_SORT_ASC::value ||
+								serial_policy_helper::IS_RADIX_SORT_DESC::value
+							)
+					> IS_ACCEPTABLE;
+
+					typedef kerbal::type_traits::bool_constant<
+							serial_policy_helper::IS_RADIX_SORT_DESC::value
+					> ORDER;
+			};
+
+			template <typename RandomAccessIterator, typename Order>
+			void adaptive_sort_counting_sort(RandomAccessIterator first, RandomAccessIterator last,
+											unsigned long long base, size_t buckets, Order /*order*/)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				std::vector<size_t> cnt(buckets, 0);
+				for (iterator it(first); it != last; ++it) {
+					++cnt[static_cast<size_t>(static_cast<unsigned long long>(*it) - base)];
+				}
+				if (Order::value) {
+					size_t i = buckets;
+					while (i > 0) {
+						--i;
+						value_type current(static_cast<value_type>(base + i));
+						detail::pigeonhole_sort_back_fill_n(first, cnt[i], current);
+					}
+				} else {
+					for (size_t i = 0; i < buckets; ++i) {
+						value_type current(static_cast<value_type>(base + i));
+						detail::pigeonhole_sort_back_fill_n(first, cnt[i], current);
+					}
+				}
+			}
+
+			template <typename RandomAccessIterator, typename Compare, typename StatsCallback>
+			bool adaptive_sort_try_counting_sort(RandomAccessIterator, RandomAccessIterator, Compare &,
+												adaptive_sort_stats &, StatsCallback &,
+												kerbal::type_traits::false_type /*acceptable*/)
+			{
+				return false;
+			}
+
+			/*
+			 * The keys span at most as many values as the elements: a full minmax pass is taken only if the sampled
+			 * keys already span less than that, then the elements are counted in the buckets of all the values.
+			 */
+			template <typename RandomAccessIterator, typename Compare, typename StatsCallback>
+			bool adaptive_sort_try_counting_sort(RandomAccessIterator first, RandomAccessIterator last, Compare &,
+												adaptive_sort_stats & stats, StatsCallback & callback,
+												kerbal::type_traits::true_type /*acceptable*/)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef unsigned long long ull;
+
+				const size_t len = stats.length;
+				const size_t samples = adaptive_sort_sample_num<iterator>::value < len ?
+										adaptive_sort_sample_num<iterator>::value : len;
+				value_type mini(*first);
+				value_type maxi(*first);
+				for (size_t s = 0; s < samples; ++s) {
+					const value_type & e = first[static_cast<difference_type>(s * (len - 1) / (samples - 1))];
+					if (e < mini) {
+						mini = e;
+					} else if (maxi < e) {
+						maxi = e;
+					}
+				}
+				if (static_cast<ull>(maxi) - static_cast<ull>(mini) >= len) {
+					return false;
+				}
+
+				std::pair<iterator, iterator> minmax(kerbal::algorithm::minmax_element(first, last));
+				const ull base = static_cast<ull>(*minmax.first);
+				const ull span = static_cast<ull>(*minmax.second) - base;
+				stats.key_span = span;
+				if (span >= len) {
+					return false;
+				}
+
+				stats.decision = adaptive_sort_decision::COUNTING_SORT;
+				callback(static_cast<const adaptive_sort_stats &>(stats));
+				detail::adaptive_sort_counting_sort(first, last, base, static_cast<size_t>(span) + 1,
+													typename adaptive_sort_counting_sort_policy_helper<iterator, Compare>::ORDER());
+				return true;
+			}
+
+			/*
+			 * what kerbal::algorithm::sort does with the policy, including its turning from the radix sort to
+			 * the comparison sort
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			adaptive_sort_decision::type adaptive_sort_fallback_decision(size_t sort_policy) KERBAL_NOEXCEPT
+			{
+				switch (sort_policy) {
+					case 0:
+					case 1:
+						return adaptive_sort_decision::PIGEONHOLE_SORT;
+					case 2:
+					case 3:
+						return sort_radix_sort_use_compare_sort<RandomAccessIterator, Compare>() ?
+								adaptive_sort_decision::INTRO_SORT :
+								adaptive_sort_decision::RADIX_SORT;
+					case 6:
+					case 7:
+						return adaptive_sort_decision::RADIX_SORT;
+					default:
+						return adaptive_sort_decision::INTRO_SORT;
+				}
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Sort [first, last) by the algorithm chosen by measuring the input at runtime. Not stable.
+		 *
+		 * A few adjacent pairs are sampled at first, then
+		 *   - a range found to be sorted is left as it is;
+		 *   - a range found to be in descending order is reversed;
+		 *   - a range made of a few monotonic runs is sorted by tim_sort, which merges them;
+		 *   - a range of integers whose keys span fewer values than the elements is sorted by counting;
+		 *   - else it is sorted by kerbal::algorithm::sort, which may be pigeonhole, radix or intro sort by the types.
+		 * The checks not taken cost O(1), the ones taken cost one pass at most.
+		 *
+		 * @param callback called with the adaptive_sort_stats once the decision is made, before the sorting.
+		 */
+		template <typename RandomAccessIterator, typename Compare, typename StatsCallback>
+		void adaptive_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, StatsCallback callback)
+		{
+			typedef RandomAccessIterator iterator;
+
+			adaptive_sort_stats stats;
+			stats.length = static_cast<size_t>(kerbal::iterator::distance(first, last));
+
+			if (stats.length < 2) {
+				stats.decision = adaptive_sort_decision::ALREADY_SORTED;
+				callback(static_cast<const adaptive_sort_stats &>(stats));
+				return;
+			}
+
+			detail::adaptive_sort_sample(first, stats.length, cmp, stats);
+
+			if (stats.descents == 0 && kerbal::algorithm::is_sorted(first, last, cmp)) {
+				stats.decision = adaptive_sort_decision::ALREADY_SORTED;
+				callback(static_cast<const adaptive_sort_stats &>(stats));
+				return;
+			}
+
+			if (stats.ascents == 0 &&
+				kerbal::algorithm::is_sorted(first, last, detail::tim_sort_reverse_compare<Compare>(cmp))) {
+				stats.decision = adaptive_sort_decision::REVERSE;
+				callback(static_cast<const adaptive_sort_stats &>(stats));
+				kerbal::algorithm::reverse(first, last);
+				return;
+			}
+
+			if (stats.descents <= stats.samples / 8 || stats.ascents <= stats.samples / 8) {
+				const size_t limit = detail::adaptive_sort_max_runs(stats.length);
+				stats.runs = detail::adaptive_sort_count_runs(first, last, cmp, limit);
+				if (stats.runs <= limit) {
+					stats.decision = adaptive_sort_decision::MERGE_RUNS;
+					callback(static_cast<const adaptive_sort_stats &>(stats));
+					kerbal::algorithm::tim_sort(first, last, cmp);
+					return;
+				}
+			}
+
+			if (detail::adaptive_sort_try_counting_sort(first, last, cmp, stats, callback,
+					typename detail::adaptive_sort_counting_sort_policy_helper<iterator, Compare>::IS_ACCEPTABLE())) {
+				return;
+			}
+
+			stats.decision = detail::adaptive_sort_fallback_decision<iterator, Compare>(
+					detail::sort_overload_policy<iterator, Compare>::value);
+			callback(static_cast<const adaptive_sort_stats &>(stats));
+			kerbal::algorithm::sort(first, last, cmp);
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		void adaptive_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			kerbal::algorithm::adaptive_sort(first, last, cmp, adaptive_sort_ignore_stats());
+		}
+
+		template <typename RandomAccessIterator>
+		void adaptive_sort(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::adaptive_sort(first, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_ADAPTIVE_SORT_HPP
@@ -0,0 +1,264 @@
+/**
+ * @file       argsort.hpp
+ * @brief
+ * @date       2020-09-01
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_ARGSORT_HPP
+#define KERBAL_ALGORITHM_SORT_ARGSORT_HPP
+
+#include <kerbal/algorithm/sort/intro_sort.hpp>
+#include <kerbal/algorithm/sort/radix_sort.hpp>
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * compare two indexes by the elements they refer to
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			struct argsort_compare
+			{
+					RandomAccessIterator first;
+					Compare cmp;
+
+					KERBAL_CONSTEXPR
+					argsort_compare(RandomAccessIterator first, Compare cmp) :
+							first(first), cmp(cmp)
+					{
+					}
+
+					template <typename Index>
+					KERBAL_CONSTEXPR
+					bool operator()(const Index & lhs, const Index & rhs) const
+					{
+						return cmp(first[lhs], first[rhs]);
+					}
+			};
+
+			/*
+			 * extract the key of the element an index refers to
+			 */
+			template <typename RandomAccessIterator, typename Extract>
+			struct argsort_radix_extract
+			{
+					typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type value_type;
+					typedef typename radix_sort_extract_key_type<Extract, value_type>::type result_type;
+
+					RandomAccessIterator first;
+					Extract & extract;
+
+					argsort_radix_extract(RandomAccessIterator first, Extract & extract) :
+							first(first), extract(extract)
+					{
+					}
+
+					template <typename Index>
+					result_type operator()(const Index & index) const
+					{
+						return extract(first[index]);
+					}
+			};
+
+			/*
+			 * fill [index_first, index_first + (last - first)) with 0, 1, 2, ...
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2>
+			KERBAL_CONSTEXPR14
+			RandomAccessIterator2
+			argsort_init_index(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first)
+			{
+				typedef RandomAccessIterator2 index_iterator;
+				typedef typename kerbal::iterator::iterator_traits<index_iterator>::value_type index_type;
+
+				index_type i = 0;
+				while (first != last) {
+					*index_first = i;
+					++i;
+					++index_first;
+					++first;
+				}
+				return index_first;
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Fill [index_first, index_first + (last - first)) with the permutation that sorts [first, last),
+		 *        i.e. first[index_first[0]], first[index_first[1]], ... are in order. [first, last) is not modified.
+		 *
+		 * The elements are never moved, so it is preferred over sorting the range itself when they are heavy.
+		 * Use apply_permutation to reorder them afterwards if needed. Not stable.
+		 *
+		 * @return index_first + (last - first)
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator2
+		argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first, Compare cmp)
+		{
+			typedef RandomAccessIterator2 index_iterator;
+
+			index_iterator index_last(detail::argsort_init_index(first, last, index_first));
+			kerbal::algorithm::intro_sort(index_first, index_last,
+										detail::argsort_compare<RandomAccessIterator, Compare>(first, cmp));
+			return index_last;
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator2
+		argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::argsort(first, last, index_first, std::less<value_type>());
+		}
+
+		/**
+		 * @brief Same as argsort, but the indexes of the equivalent elements keep their ascending order.
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+		RandomAccessIterator2
+		stable_argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first, Compare cmp)
+		{
+			typedef RandomAccessIterator2 index_iterator;
+
+			index_iterator index_last(detail::argsort_init_index(first, last, index_first));
+			kerbal::algorithm::stable_sort(index_first, index_last,
+										detail::argsort_compare<RandomAccessIterator, Compare>(first, cmp));
+			return index_last;
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		RandomAccessIterator2
+		stable_argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::stable_argsort(first, last, index_first, std::less<value_type>());
+		}
+
+		/**
+		 * @brief Stable argsort by the keys extracted by `extract`, which are sorted by radix_sort_by_key.
+		 *
+		 * The key should be acceptable to radix sort (see is_radix_sort_acceptable_type).
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order,
+					size_t RADIX_BIT_WIDTH>
+		RandomAccessIterator2
+		radix_argsort_by_key(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first,
+							Extract extract, Order order,
+							kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator2 index_iterator;
+
+			index_iterator index_last(detail::argsort_init_index(first, last, index_first));
+			kerbal::algorithm::radix_sort_by_key(index_first, index_last,
+												detail::argsort_radix_extract<RandomAccessIterator, Extract>(first, extract),
+												order, radix_bit_width);
+			return index_last;
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order>
+		RandomAccessIterator2
+		radix_argsort_by_key(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first,
+							Extract extract, Order order)
+		{
+			return kerbal::algorithm::radix_argsort_by_key(first, last, index_first, extract, order,
+														kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract>
+		RandomAccessIterator2
+		radix_argsort_by_key(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first,
+							Extract extract)
+		{
+			return kerbal::algorithm::radix_argsort_by_key(first, last, index_first, extract,
+														kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Order>
+		RandomAccessIterator2
+		radix_argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first,
+						Order order)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::radix_argsort_by_key(first, last, index_first,
+														detail::radix_sort_identity_extract<value_type>(), order);
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		RandomAccessIterator2
+		radix_argsort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first)
+		{
+			return kerbal::algorithm::radix_argsort(first, last, index_first, kerbal::type_traits::false_type());
+		}
+
+		/**
+		 * @brief Reorder [first, last) so that the i-th element becomes the index_first[i]-th one of the original
+		 *        range, e.g. by the permutation given by argsort.
+		 *
+		 * Every element is moved once, cycle by cycle, with only one temporary element.
+		 * The permutation is consumed: [index_first, index_first + (last - first)) becomes 0, 1, 2, ... after that.
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		KERBAL_CONSTEXPR14
+		void apply_permutation(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 index_first)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+			typedef RandomAccessIterator2 index_iterator;
+			typedef typename kerbal::iterator::iterator_traits<index_iterator>::value_type index_type;
+
+			const difference_type len(kerbal::iterator::distance(first, last));
+			for (difference_type i = 0; i < len; ++i) {
+				if (static_cast<difference_type>(index_first[i]) == i) {
+					continue;
+				}
+				value_type tmp(kerbal::compatibility::to_xvalue(first[i]));
+				difference_type j = i;
+				while (true) {
+					difference_type k = static_cast<difference_type>(index_first[j]);
+					index_first[j] = static_cast<index_type>(j);
+					if (k == i) {
+						break;
+					}
+					first[j] = kerbal::compatibility::to_xvalue(first[k]);
+					j = k;
+				}
+				first[j] = kerbal::compatibility::to_xvalue(tmp);
+			}
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_ARGSORT_HPP
@@ -0,0 +1,81 @@
+/**
+ * @file       compare_by_key.hpp
+ * @brief
+ * @date       2020-08-24
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_COMPARE_BY_KEY_HPP
+#define KERBAL_ALGORITHM_SORT_COMPARE_BY_KEY_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		/**
+		 * @brief Compare two entities by the keys extracted from them.
+		 *
+		 * Passing it to kerbal::algorithm::sort with KeyCompare being std::less<Key> or std::greater<Key> lets
+		 * sort choose radix_sort_by_key when Key is acceptable to radix sort.
+		 */
+		template <typename Key, typename Extract, typename KeyCompare = std::less<Key> >
+		struct compare_by_key
+		{
+				typedef Key key_type;
+				typedef Extract extract_type;
+				typedef KeyCompare key_compare;
+
+				Extract extract;
+				KeyCompare kc;
+
+				KERBAL_CONSTEXPR
+				compare_by_key() :
+						extract(), kc()
+				{
+				}
+
+				KERBAL_CONSTEXPR
+				explicit compare_by_key(const Extract & extract, const KeyCompare & kc = KeyCompare()) :
+						extract(extract), kc(kc)
+				{
+				}
+
+				template <typename Entity>
+				KERBAL_CONSTEXPR
+				bool operator()(const Entity & lhs, const Entity & rhs) const
+				{
+					return kc(extract(lhs), extract(rhs));
+				}
+		};
+
+		template <typename Key, typename Extract>
+		KERBAL_CONSTEXPR
+		compare_by_key<Key, Extract>
+		make_compare_by_key(const Extract & extract)
+		{
+			return compare_by_key<Key, Extract>(extract);
+		}
+
+		template <typename Key, typename Extract, typename KeyCompare>
+		KERBAL_CONSTEXPR
+		compare_by_key<Key, Extract, KeyCompare>
+		make_compare_by_key(const Extract & extract, const KeyCompare & kc)
+		{
+			return compare_by_key<Key, Extract, KeyCompare>(extract, kc);
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_COMPARE_BY_KEY_HPP
@@ -0,0 +1,362 @@
+/**
+ * @file       pdq_sort_partition.hpp
+ * @brief
+ * @date       2020-08-27
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_DETAIL_PDQ_SORT_PARTITION_HPP
+#define KERBAL_ALGORITHM_SORT_DETAIL_PDQ_SORT_PARTITION_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * The block partition trades the branches of the comparisons for extra moves,
+			 * which pays off only when comparing is cheap and unpredictable.
+			 */
+			template <typename Tp, typename Compare>
+			struct pdq_sort_is_branchless:
+					kerbal::type_traits::bool_constant<
+							kerbal::type_traits::is_arithmetic<Tp>::value &&
+							(
+								kerbal::type_traits::is_same<Compare, std::less<Tp> >::value ||
+								kerbal::type_traits::is_same<Compare, std::greater<Tp> >::value
+							)
+					>
+			{
+			};
+
+			template <typename RandomAccessIterator, typename Compare>
+			void pdq_sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare & cmp)
+			{
+				if (cmp(*b, *a)) {
+					kerbal::algorithm::iter_swap(a, b);
+				}
+				if (cmp(*c, *b)) {
+					kerbal::algorithm::iter_swap(b, c);
+					if (cmp(*b, *a)) {
+						kerbal::algorithm::iter_swap(a, b);
+					}
+				}
+			}
+
+			/*
+			 * Insertion sort which gives up once more than 8 elements have been moved.
+			 *
+			 * @return true if [first, last) has been sorted
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			bool pdq_sort_partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				if (first == last) {
+					return true;
+				}
+
+				difference_type moved = 0;
+				for (iterator cur(first + 1); cur != last; ++cur) {
+					iterator sift(cur);
+					iterator sift_1(cur - 1);
+					if (cmp(*sift, *sift_1)) {
+						value_type tmp(kerbal::compatibility::to_xvalue(*sift));
+						do {
+							*sift = kerbal::compatibility::to_xvalue(*sift_1);
+							--sift;
+						} while (sift != first && cmp(tmp, *--sift_1));
+						*sift = kerbal::compatibility::to_xvalue(tmp);
+						moved += cur - sift;
+					}
+					if (moved > 8) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/*
+			 * Partition [first, last) by the pivot *first into [first, pivot_pos) < pivot <= [pivot_pos + 1, last).
+			 * [first, last) should be at least 3 long, and there should be an element not less than the pivot
+			 * in (first, last), which is guaranteed by the median selection.
+			 *
+			 * @return the pivot position, and whether [first, last) has already been partitioned without any swap
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			std::pair<RandomAccessIterator, bool>
+			pdq_sort_partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+									kerbal::type_traits::false_type /*branchless*/)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				value_type pivot(kerbal::compatibility::to_xvalue(*first));
+				iterator l(first);
+				iterator r(last);
+
+				while (cmp(*++l, pivot)) {
+				}
+				if (l - 1 == first) {
+					while (l < r && !cmp(*--r, pivot)) {
+					}
+				} else {
+					while (!cmp(*--r, pivot)) {
+					}
+				}
+
+				bool already_partitioned = l >= r;
+				while (l < r) {
+					kerbal::algorithm::iter_swap(l, r);
+					while (cmp(*++l, pivot)) {
+					}
+					while (!cmp(*--r, pivot)) {
+					}
+				}
+
+				iterator pivot_pos(l - 1);
+				*first = kerbal::compatibility::to_xvalue(*pivot_pos);
+				*pivot_pos = kerbal::compatibility::to_xvalue(pivot);
+				return std::pair<iterator, bool>(pivot_pos, already_partitioned);
+			}
+
+			/*
+			 * Exchange l_base[offsets_l[i]] with r_base[-offsets_r[i]], for i in [0, num),
+			 * by one cyclic permutation unless use_swaps.
+			 */
+			template <typename RandomAccessIterator>
+			void pdq_sort_swap_offsets(RandomAccessIterator l_base, RandomAccessIterator r_base,
+									const unsigned char * offsets_l, const unsigned char * offsets_r,
+									size_t num, bool use_swaps)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				if (use_swaps) {
+					for (size_t i = 0; i < num; ++i) {
+						kerbal::algorithm::iter_swap(l_base + offsets_l[i], r_base - offsets_r[i]);
+					}
+				} else if (num > 0) {
+					iterator l(l_base + offsets_l[0]);
+					iterator r(r_base - offsets_r[0]);
+					value_type tmp(kerbal::compatibility::to_xvalue(*l));
+					*l = kerbal::compatibility::to_xvalue(*r);
+					for (size_t i = 1; i < num; ++i) {
+						l = l_base + offsets_l[i];
+						*r = kerbal::compatibility::to_xvalue(*l);
+						r = r_base - offsets_r[i];
+						*l = kerbal::compatibility::to_xvalue(*r);
+					}
+					*r = kerbal::compatibility::to_xvalue(tmp);
+				}
+			}
+
+			/*
+			 * Block partition (BlockQuicksort, Edelkamp and Weiss):
+			 * the offsets of the misplaced elements of a block on each side are recorded without branches,
+			 * then swapped pairwise. Same post conditions as the branchy version.
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			std::pair<RandomAccessIterator, bool>
+			pdq_sort_partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+									kerbal::type_traits::true_type /*branchless*/)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef kerbal::type_traits::integral_constant<size_t, 64> BLOCK_SIZE;
+
+				value_type pivot(kerbal::compatibility::to_xvalue(*first));
+				iterator l(first);
+				iterator r(last);
+
+				while (cmp(*++l, pivot)) {
+				}
+				if (l - 1 == first) {
+					while (l < r && !cmp(*--r, pivot)) {
+					}
+				} else {
+					while (!cmp(*--r, pivot)) {
+					}
+				}
+
+				bool already_partitioned = l >= r;
+				if (!already_partitioned) {
+					kerbal::algorithm::iter_swap(l, r);
+					++l;
+
+					unsigned char offsets_l[BLOCK_SIZE::value];
+					unsigned char offsets_r[BLOCK_SIZE::value];
+					size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+					while (static_cast<size_t>(r - l) > 2 * BLOCK_SIZE::value) {
+						if (num_l == 0) {
+							start_l = 0;
+							iterator it(l);
+							for (size_t i = 0; i < BLOCK_SIZE::value; ++i) {
+								offsets_l[num_l] = static_cast<unsigned char>(i);
+								num_l += !cmp(*it, pivot);
+								++it;
+							}
+						}
+						if (num_r == 0) {
+							start_r = 0;
+							iterator it(r);
+							for (size_t i = 0; i < BLOCK_SIZE::value; ++i) {
+								offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+								num_r += cmp(*--it, pivot);
+							}
+						}
+
+						size_t num = num_l < num_r ? num_l : num_r;
+						detail::pdq_sort_swap_offsets(l, r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+						num_l -= num;
+						num_r -= num;
+						start_l += num;
+						start_r += num;
+						if (num_l == 0) {
+							l += BLOCK_SIZE::value;
+						}
+						if (num_r == 0) {
+							r -= BLOCK_SIZE::value;
+						}
+					}
+
+					size_t l_size = 0, r_size = 0;
+					size_t unknown_left = static_cast<size_t>(r - l) - ((num_r || num_l) ? BLOCK_SIZE::value : 0);
+					if (num_r) {
+						// the leftover block is on the right side, the unknown elements go to the left one
+						l_size = unknown_left;
+						r_size = BLOCK_SIZE::value;
+					} else if (num_l) {
+						l_size = BLOCK_SIZE::value;
+						r_size = unknown_left;
+					} else {
+						l_size = unknown_left / 2;
+						r_size = unknown_left - l_size;
+					}
+
+					if (unknown_left && !num_l) {
+						start_l = 0;
+						iterator it(l);
+						for (size_t i = 0; i < l_size; ++i) {
+							offsets_l[num_l] = static_cast<unsigned char>(i);
+							num_l += !cmp(*it, pivot);
+							++it;
+						}
+					}
+					if (unknown_left && !num_r) {
+						start_r = 0;
+						iterator it(r);
+						for (size_t i = 0; i < r_size; ++i) {
+							offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+							num_r += cmp(*--it, pivot);
+						}
+					}
+
+					size_t num = num_l < num_r ? num_l : num_r;
+					detail::pdq_sort_swap_offsets(l, r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+					num_l -= num;
+					num_r -= num;
+					start_l += num;
+					start_r += num;
+					if (num_l == 0) {
+						l += l_size;
+					}
+					if (num_r == 0) {
+						r -= r_size;
+					}
+
+					// the position of [l, r) is known now, move the misplaced elements of the leftover block
+					if (num_l) {
+						while (num_l--) {
+							kerbal::algorithm::iter_swap(l + offsets_l[start_l + num_l], --r);
+						}
+						l = r;
+					}
+					if (num_r) {
+						while (num_r--) {
+							kerbal::algorithm::iter_swap(r - offsets_r[start_r + num_r], l);
+							++l;
+						}
+						r = l;
+					}
+				}
+
+				iterator pivot_pos(l - 1);
+				*first = kerbal::compatibility::to_xvalue(*pivot_pos);
+				*pivot_pos = kerbal::compatibility::to_xvalue(pivot);
+				return std::pair<iterator, bool>(pivot_pos, already_partitioned);
+			}
+
+			/*
+			 * Partition [first, last) by the pivot *first into [first, pivot_pos] <= pivot < [pivot_pos + 1, last).
+			 * Used when the pivot equals to the element just before first, so that all the elements equal to
+			 * the pivot are put into their final place at once.
+			 *
+			 * @return the pivot position
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			RandomAccessIterator
+			pdq_sort_partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				value_type pivot(kerbal::compatibility::to_xvalue(*first));
+				iterator l(first);
+				iterator r(last);
+
+				while (cmp(pivot, *--r)) {
+				}
+				if (r + 1 == last) {
+					while (l < r && !cmp(pivot, *++l)) {
+					}
+				} else {
+					while (!cmp(pivot, *++l)) {
+					}
+				}
+
+				while (l < r) {
+					kerbal::algorithm::iter_swap(l, r);
+					while (cmp(pivot, *--r)) {
+					}
+					while (!cmp(pivot, *++l)) {
+					}
+				}
+
+				iterator pivot_pos(r);
+				*first = kerbal::compatibility::to_xvalue(*pivot_pos);
+				*pivot_pos = kerbal::compatibility::to_xvalue(pivot);
+				return pivot_pos;
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_DETAIL_PDQ_SORT_PARTITION_HPP
@@ -0,0 +1,561 @@
+/**
+ * @file       sorting_network.hpp
+ * @brief
+ * @date       2020-08-30
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_HPP
+#define KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/conditional.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+
+
+/*
+ * The SIMD kernels can't be evaluated at compile time, so since C++14, in which the sorts are constexpr,
+ * they are only taken when the compiler is able to tell the constant evaluation.
+ * AVX2 sorts 8 lanes a register, SSE4.1 is the fallback of 4 lanes for the targets without AVX2.
+ */
+#ifndef KERBAL_ENABLE_SORTING_NETWORK_AVX2
+#	if defined(__AVX2__)
+#		define KERBAL_ENABLE_SORTING_NETWORK_AVX2 1
+#	else
+#		define KERBAL_ENABLE_SORTING_NETWORK_AVX2 0
+#	endif
+#endif
+
+#ifndef KERBAL_ENABLE_SORTING_NETWORK_SSE
+#	if defined(__SSE4_1__) && !KERBAL_ENABLE_SORTING_NETWORK_AVX2
+#		define KERBAL_ENABLE_SORTING_NETWORK_SSE 1
+#	else
+#		define KERBAL_ENABLE_SORTING_NETWORK_SSE 0
+#	endif
+#endif
+
+#if KERBAL_ENABLE_SORTING_NETWORK_AVX2
+#	include <kerbal/algorithm/sort/detail/sorting_network_avx2.hpp>
+#elif KERBAL_ENABLE_SORTING_NETWORK_SSE
+#	include <kerbal/algorithm/sort/detail/sorting_network_sse.hpp>
+#endif
+
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * written as selections rather than a branch, so that it is compiled to cmov or min/max
+			 */
+			template <typename Tp, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network_cas(Tp & x, Tp & y, Compare & cmp)
+			{
+				const Tp t(x);
+				const bool c = static_cast<bool>(cmp(y, x));
+				x = c ? y : x;
+				y = c ? t : y;
+			}
+
+			/*
+			 * The networks below are Batcher's odd-even merge sort networks, with 19, 63 and 191 comparators.
+			 */
+
+			template <typename Tp, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network(Tp (&a)[8], Compare & cmp)
+			{
+				detail::sorting_network_cas(a[0], a[1], cmp);
+				detail::sorting_network_cas(a[2], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[7], cmp);
+				detail::sorting_network_cas(a[0], a[2], cmp);
+				detail::sorting_network_cas(a[1], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[6], cmp);
+				detail::sorting_network_cas(a[5], a[7], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[0], a[4], cmp);
+				detail::sorting_network_cas(a[1], a[5], cmp);
+				detail::sorting_network_cas(a[2], a[6], cmp);
+				detail::sorting_network_cas(a[3], a[7], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+			}
+
+			template <typename Tp, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network(Tp (&a)[16], Compare & cmp)
+			{
+				detail::sorting_network_cas(a[0], a[1], cmp);
+				detail::sorting_network_cas(a[2], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[9], cmp);
+				detail::sorting_network_cas(a[10], a[11], cmp);
+				detail::sorting_network_cas(a[12], a[13], cmp);
+				detail::sorting_network_cas(a[14], a[15], cmp);
+				detail::sorting_network_cas(a[0], a[2], cmp);
+				detail::sorting_network_cas(a[1], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[6], cmp);
+				detail::sorting_network_cas(a[5], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[10], cmp);
+				detail::sorting_network_cas(a[9], a[11], cmp);
+				detail::sorting_network_cas(a[12], a[14], cmp);
+				detail::sorting_network_cas(a[13], a[15], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[0], a[4], cmp);
+				detail::sorting_network_cas(a[1], a[5], cmp);
+				detail::sorting_network_cas(a[2], a[6], cmp);
+				detail::sorting_network_cas(a[3], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[12], cmp);
+				detail::sorting_network_cas(a[9], a[13], cmp);
+				detail::sorting_network_cas(a[10], a[14], cmp);
+				detail::sorting_network_cas(a[11], a[15], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[10], a[12], cmp);
+				detail::sorting_network_cas(a[11], a[13], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[11], a[12], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[0], a[8], cmp);
+				detail::sorting_network_cas(a[1], a[9], cmp);
+				detail::sorting_network_cas(a[2], a[10], cmp);
+				detail::sorting_network_cas(a[3], a[11], cmp);
+				detail::sorting_network_cas(a[4], a[12], cmp);
+				detail::sorting_network_cas(a[5], a[13], cmp);
+				detail::sorting_network_cas(a[6], a[14], cmp);
+				detail::sorting_network_cas(a[7], a[15], cmp);
+				detail::sorting_network_cas(a[4], a[8], cmp);
+				detail::sorting_network_cas(a[5], a[9], cmp);
+				detail::sorting_network_cas(a[6], a[10], cmp);
+				detail::sorting_network_cas(a[7], a[11], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[8], cmp);
+				detail::sorting_network_cas(a[7], a[9], cmp);
+				detail::sorting_network_cas(a[10], a[12], cmp);
+				detail::sorting_network_cas(a[11], a[13], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[7], a[8], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[11], a[12], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+			}
+
+			template <typename Tp, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network(Tp (&a)[32], Compare & cmp)
+			{
+				detail::sorting_network_cas(a[0], a[1], cmp);
+				detail::sorting_network_cas(a[2], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[9], cmp);
+				detail::sorting_network_cas(a[10], a[11], cmp);
+				detail::sorting_network_cas(a[12], a[13], cmp);
+				detail::sorting_network_cas(a[14], a[15], cmp);
+				detail::sorting_network_cas(a[16], a[17], cmp);
+				detail::sorting_network_cas(a[18], a[19], cmp);
+				detail::sorting_network_cas(a[20], a[21], cmp);
+				detail::sorting_network_cas(a[22], a[23], cmp);
+				detail::sorting_network_cas(a[24], a[25], cmp);
+				detail::sorting_network_cas(a[26], a[27], cmp);
+				detail::sorting_network_cas(a[28], a[29], cmp);
+				detail::sorting_network_cas(a[30], a[31], cmp);
+				detail::sorting_network_cas(a[0], a[2], cmp);
+				detail::sorting_network_cas(a[1], a[3], cmp);
+				detail::sorting_network_cas(a[4], a[6], cmp);
+				detail::sorting_network_cas(a[5], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[10], cmp);
+				detail::sorting_network_cas(a[9], a[11], cmp);
+				detail::sorting_network_cas(a[12], a[14], cmp);
+				detail::sorting_network_cas(a[13], a[15], cmp);
+				detail::sorting_network_cas(a[16], a[18], cmp);
+				detail::sorting_network_cas(a[17], a[19], cmp);
+				detail::sorting_network_cas(a[20], a[22], cmp);
+				detail::sorting_network_cas(a[21], a[23], cmp);
+				detail::sorting_network_cas(a[24], a[26], cmp);
+				detail::sorting_network_cas(a[25], a[27], cmp);
+				detail::sorting_network_cas(a[28], a[30], cmp);
+				detail::sorting_network_cas(a[29], a[31], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[17], a[18], cmp);
+				detail::sorting_network_cas(a[21], a[22], cmp);
+				detail::sorting_network_cas(a[25], a[26], cmp);
+				detail::sorting_network_cas(a[29], a[30], cmp);
+				detail::sorting_network_cas(a[0], a[4], cmp);
+				detail::sorting_network_cas(a[1], a[5], cmp);
+				detail::sorting_network_cas(a[2], a[6], cmp);
+				detail::sorting_network_cas(a[3], a[7], cmp);
+				detail::sorting_network_cas(a[8], a[12], cmp);
+				detail::sorting_network_cas(a[9], a[13], cmp);
+				detail::sorting_network_cas(a[10], a[14], cmp);
+				detail::sorting_network_cas(a[11], a[15], cmp);
+				detail::sorting_network_cas(a[16], a[20], cmp);
+				detail::sorting_network_cas(a[17], a[21], cmp);
+				detail::sorting_network_cas(a[18], a[22], cmp);
+				detail::sorting_network_cas(a[19], a[23], cmp);
+				detail::sorting_network_cas(a[24], a[28], cmp);
+				detail::sorting_network_cas(a[25], a[29], cmp);
+				detail::sorting_network_cas(a[26], a[30], cmp);
+				detail::sorting_network_cas(a[27], a[31], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[10], a[12], cmp);
+				detail::sorting_network_cas(a[11], a[13], cmp);
+				detail::sorting_network_cas(a[18], a[20], cmp);
+				detail::sorting_network_cas(a[19], a[21], cmp);
+				detail::sorting_network_cas(a[26], a[28], cmp);
+				detail::sorting_network_cas(a[27], a[29], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[11], a[12], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[17], a[18], cmp);
+				detail::sorting_network_cas(a[19], a[20], cmp);
+				detail::sorting_network_cas(a[21], a[22], cmp);
+				detail::sorting_network_cas(a[25], a[26], cmp);
+				detail::sorting_network_cas(a[27], a[28], cmp);
+				detail::sorting_network_cas(a[29], a[30], cmp);
+				detail::sorting_network_cas(a[0], a[8], cmp);
+				detail::sorting_network_cas(a[1], a[9], cmp);
+				detail::sorting_network_cas(a[2], a[10], cmp);
+				detail::sorting_network_cas(a[3], a[11], cmp);
+				detail::sorting_network_cas(a[4], a[12], cmp);
+				detail::sorting_network_cas(a[5], a[13], cmp);
+				detail::sorting_network_cas(a[6], a[14], cmp);
+				detail::sorting_network_cas(a[7], a[15], cmp);
+				detail::sorting_network_cas(a[16], a[24], cmp);
+				detail::sorting_network_cas(a[17], a[25], cmp);
+				detail::sorting_network_cas(a[18], a[26], cmp);
+				detail::sorting_network_cas(a[19], a[27], cmp);
+				detail::sorting_network_cas(a[20], a[28], cmp);
+				detail::sorting_network_cas(a[21], a[29], cmp);
+				detail::sorting_network_cas(a[22], a[30], cmp);
+				detail::sorting_network_cas(a[23], a[31], cmp);
+				detail::sorting_network_cas(a[4], a[8], cmp);
+				detail::sorting_network_cas(a[5], a[9], cmp);
+				detail::sorting_network_cas(a[6], a[10], cmp);
+				detail::sorting_network_cas(a[7], a[11], cmp);
+				detail::sorting_network_cas(a[20], a[24], cmp);
+				detail::sorting_network_cas(a[21], a[25], cmp);
+				detail::sorting_network_cas(a[22], a[26], cmp);
+				detail::sorting_network_cas(a[23], a[27], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[8], cmp);
+				detail::sorting_network_cas(a[7], a[9], cmp);
+				detail::sorting_network_cas(a[10], a[12], cmp);
+				detail::sorting_network_cas(a[11], a[13], cmp);
+				detail::sorting_network_cas(a[18], a[20], cmp);
+				detail::sorting_network_cas(a[19], a[21], cmp);
+				detail::sorting_network_cas(a[22], a[24], cmp);
+				detail::sorting_network_cas(a[23], a[25], cmp);
+				detail::sorting_network_cas(a[26], a[28], cmp);
+				detail::sorting_network_cas(a[27], a[29], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[7], a[8], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[11], a[12], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[17], a[18], cmp);
+				detail::sorting_network_cas(a[19], a[20], cmp);
+				detail::sorting_network_cas(a[21], a[22], cmp);
+				detail::sorting_network_cas(a[23], a[24], cmp);
+				detail::sorting_network_cas(a[25], a[26], cmp);
+				detail::sorting_network_cas(a[27], a[28], cmp);
+				detail::sorting_network_cas(a[29], a[30], cmp);
+				detail::sorting_network_cas(a[0], a[16], cmp);
+				detail::sorting_network_cas(a[1], a[17], cmp);
+				detail::sorting_network_cas(a[2], a[18], cmp);
+				detail::sorting_network_cas(a[3], a[19], cmp);
+				detail::sorting_network_cas(a[4], a[20], cmp);
+				detail::sorting_network_cas(a[5], a[21], cmp);
+				detail::sorting_network_cas(a[6], a[22], cmp);
+				detail::sorting_network_cas(a[7], a[23], cmp);
+				detail::sorting_network_cas(a[8], a[24], cmp);
+				detail::sorting_network_cas(a[9], a[25], cmp);
+				detail::sorting_network_cas(a[10], a[26], cmp);
+				detail::sorting_network_cas(a[11], a[27], cmp);
+				detail::sorting_network_cas(a[12], a[28], cmp);
+				detail::sorting_network_cas(a[13], a[29], cmp);
+				detail::sorting_network_cas(a[14], a[30], cmp);
+				detail::sorting_network_cas(a[15], a[31], cmp);
+				detail::sorting_network_cas(a[8], a[16], cmp);
+				detail::sorting_network_cas(a[9], a[17], cmp);
+				detail::sorting_network_cas(a[10], a[18], cmp);
+				detail::sorting_network_cas(a[11], a[19], cmp);
+				detail::sorting_network_cas(a[12], a[20], cmp);
+				detail::sorting_network_cas(a[13], a[21], cmp);
+				detail::sorting_network_cas(a[14], a[22], cmp);
+				detail::sorting_network_cas(a[15], a[23], cmp);
+				detail::sorting_network_cas(a[4], a[8], cmp);
+				detail::sorting_network_cas(a[5], a[9], cmp);
+				detail::sorting_network_cas(a[6], a[10], cmp);
+				detail::sorting_network_cas(a[7], a[11], cmp);
+				detail::sorting_network_cas(a[12], a[16], cmp);
+				detail::sorting_network_cas(a[13], a[17], cmp);
+				detail::sorting_network_cas(a[14], a[18], cmp);
+				detail::sorting_network_cas(a[15], a[19], cmp);
+				detail::sorting_network_cas(a[20], a[24], cmp);
+				detail::sorting_network_cas(a[21], a[25], cmp);
+				detail::sorting_network_cas(a[22], a[26], cmp);
+				detail::sorting_network_cas(a[23], a[27], cmp);
+				detail::sorting_network_cas(a[2], a[4], cmp);
+				detail::sorting_network_cas(a[3], a[5], cmp);
+				detail::sorting_network_cas(a[6], a[8], cmp);
+				detail::sorting_network_cas(a[7], a[9], cmp);
+				detail::sorting_network_cas(a[10], a[12], cmp);
+				detail::sorting_network_cas(a[11], a[13], cmp);
+				detail::sorting_network_cas(a[14], a[16], cmp);
+				detail::sorting_network_cas(a[15], a[17], cmp);
+				detail::sorting_network_cas(a[18], a[20], cmp);
+				detail::sorting_network_cas(a[19], a[21], cmp);
+				detail::sorting_network_cas(a[22], a[24], cmp);
+				detail::sorting_network_cas(a[23], a[25], cmp);
+				detail::sorting_network_cas(a[26], a[28], cmp);
+				detail::sorting_network_cas(a[27], a[29], cmp);
+				detail::sorting_network_cas(a[1], a[2], cmp);
+				detail::sorting_network_cas(a[3], a[4], cmp);
+				detail::sorting_network_cas(a[5], a[6], cmp);
+				detail::sorting_network_cas(a[7], a[8], cmp);
+				detail::sorting_network_cas(a[9], a[10], cmp);
+				detail::sorting_network_cas(a[11], a[12], cmp);
+				detail::sorting_network_cas(a[13], a[14], cmp);
+				detail::sorting_network_cas(a[15], a[16], cmp);
+				detail::sorting_network_cas(a[17], a[18], cmp);
+				detail::sorting_network_cas(a[19], a[20], cmp);
+				detail::sorting_network_cas(a[21], a[22], cmp);
+				detail::sorting_network_cas(a[23], a[24], cmp);
+				detail::sorting_network_cas(a[25], a[26], cmp);
+				detail::sorting_network_cas(a[27], a[28], cmp);
+				detail::sorting_network_cas(a[29], a[30], cmp);
+			}
+
+			template <typename Compare>
+			struct sorting_network_order;
+
+			template <typename Tp>
+			struct sorting_network_order<std::less<Tp> >: kerbal::type_traits::false_type
+			{
+			};
+
+			template <typename Tp>
+			struct sorting_network_order<std::greater<Tp> >: kerbal::type_traits::true_type
+			{
+			};
+
+			/*
+			 * The padding elements have to be placed after all the real ones.
+			 * The floating points use the infinities, so that a range with infinities is still sorted correctly.
+			 */
+			template <typename Tp, bool = std::numeric_limits<Tp>::has_infinity>
+			struct sorting_network_padding
+			{
+					KERBAL_CONSTEXPR
+					static Tp value(kerbal::type_traits::false_type /*asc*/)
+					{
+						return std::numeric_limits<Tp>::max();
+					}
+
+					KERBAL_CONSTEXPR
+					static Tp value(kerbal::type_traits::true_type /*desc*/)
+					{
+						return std::numeric_limits<Tp>::min();
+					}
+			};
+
+			template <typename Tp>
+			struct sorting_network_padding<Tp, true>
+			{
+					KERBAL_CONSTEXPR
+					static Tp value(kerbal::type_traits::false_type /*asc*/)
+					{
+						return std::numeric_limits<Tp>::infinity();
+					}
+
+					KERBAL_CONSTEXPR
+					static Tp value(kerbal::type_traits::true_type /*desc*/)
+					{
+						return -std::numeric_limits<Tp>::infinity();
+					}
+			};
+
+			template <typename Tp, size_t N, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network_sort(Tp (&a)[N], Compare & cmp)
+			{
+#	if KERBAL_ENABLE_SORTING_NETWORK_AVX2
+				if (!KERBAL_MAY_BE_CONSTANT_EVALUATED()) {
+					if (detail::sorting_network_avx2_sort(a,
+							kerbal::type_traits::bool_constant<sorting_network_order<Compare>::value>(),
+							kerbal::type_traits::bool_constant<sorting_network_avx2_category<Tp>::value != 0>())) {
+						return;
+					}
+				}
+#	elif KERBAL_ENABLE_SORTING_NETWORK_SSE
+				if (!KERBAL_MAY_BE_CONSTANT_EVALUATED()) {
+					if (detail::sorting_network_sse_sort(a,
+							kerbal::type_traits::bool_constant<sorting_network_order<Compare>::value>(),
+							kerbal::type_traits::bool_constant<sorting_network_sse_category<Tp>::value != 0>())) {
+						return;
+					}
+				}
+#	endif
+				detail::sorting_network(a, cmp);
+			}
+
+			/*
+			 * Copy [first, last) to an array of N elements, fill the rest with the padding, sort and copy back.
+			 */
+			template <size_t N, typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sorting_network_sort_padded(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				value_type a[N] = {};
+				value_type * p = kerbal::algorithm::copy(first, last, a + 0);
+				const value_type padding(sorting_network_padding<value_type>::value(sorting_network_order<Compare>()));
+				while (p != a + N) {
+					*p = padding;
+					++p;
+				}
+				detail::sorting_network_sort(a, cmp);
+				kerbal::algorithm::copy(a + 0, a + (last - first), first);
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			struct sorting_network_policy_helper
+			{
+					typedef ForwardIterator iterator;
+					typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							kerbal::type_traits::is_arithmetic<value_type>::value &&
+							(
+								kerbal::type_traits::is_same<Compare, std::less<value_type> >::value ||
+								kerbal::type_traits::is_same<Compare, std::greater<value_type> >::value
+							)
+					> IS_SORTING_NETWORK;
+
+					/*
+					 * the network doesn't keep the order of the equal elements, which is observable on
+					 * the floating points (0.0 and -0.0), but not on the integers
+					 */
+					typedef kerbal::type_traits::bool_constant<
+							IS_SORTING_NETWORK::value &&
+							kerbal::type_traits::is_integral<value_type>::value
+					> IS_STABLE_SORTING_NETWORK;
+
+					typedef
+					typename kerbal::type_traits::conditional<
+							IS_SORTING_NETWORK::value,
+							kerbal::type_traits::integral_constant<size_t, 1>,
+							kerbal::type_traits::integral_constant<size_t, 0>
+					>::type
+					policy;
+
+					typedef
+					typename kerbal::type_traits::conditional<
+							IS_STABLE_SORTING_NETWORK::value,
+							kerbal::type_traits::integral_constant<size_t, 1>,
+							kerbal::type_traits::integral_constant<size_t, 0>
+					>::type
+					stable_policy;
+
+			};
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void small_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+							kerbal::type_traits::integral_constant<size_t, 0>)
+			{
+				kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void small_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+							kerbal::type_traits::integral_constant<size_t, 1>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				difference_type len(last - first);
+				if (len <= 4) {
+					kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+				} else if (len <= 8) {
+					detail::sorting_network_sort_padded<8>(first, last, cmp);
+				} else if (len <= 16) {
+					detail::sorting_network_sort_padded<16>(first, last, cmp);
+				} else if (len <= 32) {
+					detail::sorting_network_sort_padded<32>(first, last, cmp);
+				} else {
+					kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+				}
+			}
+
+			/*
+			 * Sort the short partitions by the sorting networks when comparing arithmetic types by
+			 * std::less or std::greater, by directly_insertion_sort otherwise.
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void small_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
+			{
+				typedef BidirectionalIterator iterator;
+				detail::small_sort(first, last, cmp,
+						typename sorting_network_policy_helper<iterator, Compare>::policy());
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_HPP
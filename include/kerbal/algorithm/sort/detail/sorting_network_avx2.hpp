@@ -0,0 +1,208 @@
+/**
+ * @file       sorting_network_avx2.hpp
+ * @brief
+ * @date       2020-08-30
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_AVX2_HPP
+#define KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_AVX2_HPP
+
+#if defined(__AVX2__)
+
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+
+#include <cstddef>
+
+#include <immintrin.h>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename Tp, bool = kerbal::type_traits::is_integral<Tp>::value && sizeof(Tp) == 4>
+			struct sorting_network_avx2_integer_category:
+					kerbal::type_traits::integral_constant<size_t, 0>
+			{
+			};
+
+			template <typename Tp>
+			struct sorting_network_avx2_integer_category<Tp, true>:
+					kerbal::type_traits::integral_constant<size_t, kerbal::type_traits::is_signed<Tp>::value ? 1 : 2>
+			{
+			};
+
+			/*
+			 * 0: not supported, 1: 32 bits signed integer, 2: 32 bits unsigned integer
+			 *
+			 * There is no float kernel: min_ps/max_ps return the second operand on the equal inputs,
+			 * so a compare-exchange of 0.0 and -0.0 may duplicate one of them and lose the other.
+			 */
+			template <typename Tp>
+			struct sorting_network_avx2_category:
+					sorting_network_avx2_integer_category<Tp>
+			{
+			};
+
+			struct sorting_network_avx2_epi32
+			{
+					typedef __m256i vector_type;
+
+					static vector_type load(const void * p)
+					{
+						return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+					}
+
+					static void store(void * p, vector_type v)
+					{
+						_mm256_storeu_si256(static_cast<__m256i *>(p), v);
+					}
+
+					static vector_type min(vector_type a, vector_type b)
+					{
+						return _mm256_min_epi32(a, b);
+					}
+
+					static vector_type max(vector_type a, vector_type b)
+					{
+						return _mm256_max_epi32(a, b);
+					}
+
+					static vector_type permute(vector_type v, __m256i idx)
+					{
+						return _mm256_permutevar8x32_epi32(v, idx);
+					}
+
+					static vector_type blend(vector_type a, vector_type b, __m256i mask)
+					{
+						return _mm256_blendv_epi8(a, b, mask);
+					}
+			};
+
+			struct sorting_network_avx2_epu32: sorting_network_avx2_epi32
+			{
+					static vector_type min(vector_type a, vector_type b)
+					{
+						return _mm256_min_epu32(a, b);
+					}
+
+					static vector_type max(vector_type a, vector_type b)
+					{
+						return _mm256_max_epu32(a, b);
+					}
+			};
+
+			template <size_t Category>
+			struct sorting_network_avx2_ops;
+
+			template <>
+			struct sorting_network_avx2_ops<1>
+			{
+					typedef sorting_network_avx2_epi32 type;
+			};
+
+			template <>
+			struct sorting_network_avx2_ops<2>
+			{
+					typedef sorting_network_avx2_epu32 type;
+			};
+
+			/*
+			 * In-register bitonic sort of R * 8 lanes, the element i is the lane i % 8 of the register i / 8.
+			 * The compare-exchanges between the registers are plain min/max, those inside a register
+			 * pair up the lanes i and i ^ j by permutation and pick the min or the max by blending.
+			 */
+			template <typename Ops, size_t R, bool Desc>
+			void sorting_network_avx2_bitonic_sort(void * buf)
+			{
+				typedef typename Ops::vector_type vector_type;
+
+				vector_type v[R];
+				for (size_t r = 0; r < R; ++r) {
+					v[r] = Ops::load(static_cast<const char *>(buf) + r * 32);
+				}
+
+				const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+				const __m256i zero = _mm256_setzero_si256();
+				const __m256i desc = Desc ? _mm256_set1_epi32(-1) : zero;
+
+				for (size_t k = 2; k <= R * 8; k <<= 1) {
+					for (size_t j = k >> 1; j > 0; j >>= 1) {
+						if (j >= 8) {
+							const size_t jr = j / 8;
+							for (size_t r = 0; r < R; ++r) {
+								const size_t p = r ^ jr;
+								if (p < r) {
+									continue;
+								}
+								vector_type lo(Ops::min(v[r], v[p]));
+								vector_type hi(Ops::max(v[r], v[p]));
+								bool up = ((r * 8) & k) == 0;
+								if (up != Desc) {
+									v[r] = lo;
+									v[p] = hi;
+								} else {
+									v[r] = hi;
+									v[p] = lo;
+								}
+							}
+						} else {
+							const __m256i idx = _mm256_xor_si256(lane, _mm256_set1_epi32(static_cast<int>(j)));
+							const __m256i jv = _mm256_set1_epi32(static_cast<int>(j));
+							const __m256i kv = _mm256_set1_epi32(static_cast<int>(k));
+							for (size_t r = 0; r < R; ++r) {
+								const __m256i i = _mm256_add_epi32(lane, _mm256_set1_epi32(static_cast<int>(r * 8)));
+								// the lane takes the max iff (i & j) != 0 xor (i & k) != 0
+								__m256i take_max = _mm256_xor_si256(
+										_mm256_cmpeq_epi32(_mm256_and_si256(i, jv), zero),
+										_mm256_cmpeq_epi32(_mm256_and_si256(i, kv), zero));
+								take_max = _mm256_xor_si256(take_max, desc);
+								vector_type partner(Ops::permute(v[r], idx));
+								v[r] = Ops::blend(Ops::min(v[r], partner), Ops::max(v[r], partner), take_max);
+							}
+						}
+					}
+				}
+
+				for (size_t r = 0; r < R; ++r) {
+					Ops::store(static_cast<char *>(buf) + r * 32, v[r]);
+				}
+			}
+
+			template <typename Tp, size_t N, bool Desc>
+			bool sorting_network_avx2_sort(Tp (&a)[N], kerbal::type_traits::bool_constant<Desc>,
+											kerbal::type_traits::true_type /*supported*/)
+			{
+				typedef typename sorting_network_avx2_ops<sorting_network_avx2_category<Tp>::value>::type ops;
+				detail::sorting_network_avx2_bitonic_sort<ops, N / 8, Desc>(a);
+				return true;
+			}
+
+			template <typename Tp, size_t N, bool Desc>
+			bool sorting_network_avx2_sort(Tp (&)[N], kerbal::type_traits::bool_constant<Desc>,
+											kerbal::type_traits::false_type /*supported*/)
+			{
+				return false;
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // defined(__AVX2__)
+
+#endif // KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_AVX2_HPP
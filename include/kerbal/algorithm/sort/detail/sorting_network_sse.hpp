@@ -0,0 +1,212 @@
+/**
+ * @file       sorting_network_sse.hpp
+ * @brief
+ * @date       2026-10-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_SSE_HPP
+#define KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_SSE_HPP
+
+#if defined(__SSE4_1__)
+
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+
+#include <cstddef>
+
+#include <smmintrin.h>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename Tp, bool = kerbal::type_traits::is_integral<Tp>::value && sizeof(Tp) == 4>
+			struct sorting_network_sse_integer_category:
+					kerbal::type_traits::integral_constant<size_t, 0>
+			{
+			};
+
+			template <typename Tp>
+			struct sorting_network_sse_integer_category<Tp, true>:
+					kerbal::type_traits::integral_constant<size_t, kerbal::type_traits::is_signed<Tp>::value ? 1 : 2>
+			{
+			};
+
+			/*
+			 * 0: not supported, 1: 32 bits signed integer, 2: 32 bits unsigned integer
+			 *
+			 * There is no float kernel: min_ps/max_ps return the second operand on the equal inputs,
+			 * so a compare-exchange of 0.0 and -0.0 may duplicate one of them and lose the other.
+			 */
+			template <typename Tp>
+			struct sorting_network_sse_category:
+					sorting_network_sse_integer_category<Tp>
+			{
+			};
+
+			struct sorting_network_sse_epi32
+			{
+					typedef __m128i vector_type;
+
+					static vector_type load(const void * p)
+					{
+						return _mm_loadu_si128(static_cast<const __m128i *>(p));
+					}
+
+					static void store(void * p, vector_type v)
+					{
+						_mm_storeu_si128(static_cast<__m128i *>(p), v);
+					}
+
+					static vector_type min(vector_type a, vector_type b)
+					{
+						return _mm_min_epi32(a, b);
+					}
+
+					static vector_type max(vector_type a, vector_type b)
+					{
+						return _mm_max_epi32(a, b);
+					}
+
+					/*
+					 * SSE has no variable permutation, the lane i is swapped with the lane i ^ j, j = 1 or 2
+					 */
+					static vector_type swap_lanes(vector_type v, size_t j)
+					{
+						return j == 1 ?
+								_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)) :
+								_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+					}
+
+					static vector_type blend(vector_type a, vector_type b, __m128i mask)
+					{
+						return _mm_blendv_epi8(a, b, mask);
+					}
+			};
+
+			struct sorting_network_sse_epu32: sorting_network_sse_epi32
+			{
+					static vector_type min(vector_type a, vector_type b)
+					{
+						return _mm_min_epu32(a, b);
+					}
+
+					static vector_type max(vector_type a, vector_type b)
+					{
+						return _mm_max_epu32(a, b);
+					}
+			};
+
+			template <size_t Category>
+			struct sorting_network_sse_ops;
+
+			template <>
+			struct sorting_network_sse_ops<1>
+			{
+					typedef sorting_network_sse_epi32 type;
+			};
+
+			template <>
+			struct sorting_network_sse_ops<2>
+			{
+					typedef sorting_network_sse_epu32 type;
+			};
+
+			/*
+			 * In-register bitonic sort of R * 4 lanes, the element i is the lane i % 4 of the register i / 4.
+			 * The compare-exchanges between the registers are plain min/max, those inside a register
+			 * pair up the lanes i and i ^ j by shuffling and pick the min or the max by blending.
+			 */
+			template <typename Ops, size_t R, bool Desc>
+			void sorting_network_sse_bitonic_sort(void * buf)
+			{
+				typedef typename Ops::vector_type vector_type;
+
+				vector_type v[R];
+				for (size_t r = 0; r < R; ++r) {
+					v[r] = Ops::load(static_cast<const char *>(buf) + r * 16);
+				}
+
+				const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i desc = Desc ? _mm_set1_epi32(-1) : zero;
+
+				for (size_t k = 2; k <= R * 4; k <<= 1) {
+					for (size_t j = k >> 1; j > 0; j >>= 1) {
+						if (j >= 4) {
+							const size_t jr = j / 4;
+							for (size_t r = 0; r < R; ++r) {
+								const size_t p = r ^ jr;
+								if (p < r) {
+									continue;
+								}
+								vector_type lo(Ops::min(v[r], v[p]));
+								vector_type hi(Ops::max(v[r], v[p]));
+								bool up = ((r * 4) & k) == 0;
+								if (up != Desc) {
+									v[r] = lo;
+									v[p] = hi;
+								} else {
+									v[r] = hi;
+									v[p] = lo;
+								}
+							}
+						} else {
+							const __m128i jv = _mm_set1_epi32(static_cast<int>(j));
+							const __m128i kv = _mm_set1_epi32(static_cast<int>(k));
+							for (size_t r = 0; r < R; ++r) {
+								const __m128i i = _mm_add_epi32(lane, _mm_set1_epi32(static_cast<int>(r * 4)));
+								// the lane takes the max iff (i & j) != 0 xor (i & k) != 0
+								__m128i take_max = _mm_xor_si128(
+										_mm_cmpeq_epi32(_mm_and_si128(i, jv), zero),
+										_mm_cmpeq_epi32(_mm_and_si128(i, kv), zero));
+								take_max = _mm_xor_si128(take_max, desc);
+								vector_type partner(Ops::swap_lanes(v[r], j));
+								v[r] = Ops::blend(Ops::min(v[r], partner), Ops::max(v[r], partner), take_max);
+							}
+						}
+					}
+				}
+
+				for (size_t r = 0; r < R; ++r) {
+					Ops::store(static_cast<char *>(buf) + r * 16, v[r]);
+				}
+			}
+
+			template <typename Tp, size_t N, bool Desc>
+			bool sorting_network_sse_sort(Tp (&a)[N], kerbal::type_traits::bool_constant<Desc>,
+											kerbal::type_traits::true_type /*supported*/)
+			{
+				typedef typename sorting_network_sse_ops<sorting_network_sse_category<Tp>::value>::type ops;
+				detail::sorting_network_sse_bitonic_sort<ops, N / 4, Desc>(a);
+				return true;
+			}
+
+			template <typename Tp, size_t N, bool Desc>
+			bool sorting_network_sse_sort(Tp (&)[N], kerbal::type_traits::bool_constant<Desc>,
+											kerbal::type_traits::false_type /*supported*/)
+			{
+				return false;
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // defined(__SSE4_1__)
+
+#endif // KERBAL_ALGORITHM_SORT_DETAIL_SORTING_NETWORK_SSE_HPP
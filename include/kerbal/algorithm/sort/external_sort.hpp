@@ -0,0 +1,699 @@
+/**
+ * @file       external_sort.hpp
+ * @brief      Sort the fixed-size records of a file which may not fit in the memory.
+ * @date       2020-09-03
+ * @author     Peter
+ * @remark     POSIX only (pread, write, mkstemp).
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_EXTERNAL_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_EXTERNAL_SORT_HPP
+
+#include <kerbal/algorithm/k_way_merge.hpp>
+#include <kerbal/algorithm/sort/sort.hpp>
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/noncopyable.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#endif
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		class external_sort_io_exception:
+				public kerbal::utility::throw_this_exception_helper<external_sort_io_exception>,
+				public std::runtime_error
+		{
+			private:
+				int err;
+
+			public:
+				external_sort_io_exception(const char * op, int err) :
+						std::runtime_error(std::string("external sort: ") + op + ": " + std::strerror(err)),
+						err(err)
+				{
+				}
+
+				int error_code() const KERBAL_NOEXCEPT
+				{
+					return err;
+				}
+		};
+
+		struct external_sort_config
+		{
+				/**
+				 * @brief Bytes of the records which are sorted in the memory as one run.
+				 */
+				size_t run_size;
+
+				/**
+				 * @brief Max number of runs merged at one time. Passes over the temporary files are added
+				 *        while there are more runs than that.
+				 */
+				size_t fan_out;
+
+				/**
+				 * @brief Bytes of the read buffer of each merged run and of the write buffer.
+				 */
+				size_t buffer_size;
+
+				/**
+				 * @brief Directory of the temporary files, $TMPDIR or /tmp if NULL.
+				 */
+				const char * temp_dir;
+
+				external_sort_config() KERBAL_NOEXCEPT :
+						run_size(static_cast<size_t>(1) << 28), fan_out(64),
+						buffer_size(static_cast<size_t>(1) << 20), temp_dir(NULL)
+				{
+				}
+		};
+
+		namespace detail
+		{
+
+			inline
+			void external_sort_throw(const char * op)
+			{
+				kerbal::algorithm::external_sort_io_exception::throw_this_exception(op, errno);
+			}
+
+			class external_sort_fd: private kerbal::utility::noncopyable
+			{
+				public:
+					int fd;
+
+					explicit external_sort_fd(int fd = -1) KERBAL_NOEXCEPT :
+							fd(fd)
+					{
+					}
+
+					~external_sort_fd()
+					{
+						if (fd != -1) {
+							::close(fd);
+						}
+					}
+
+					/*
+					 * Close and check the result, as the write back errors may only be reported here.
+					 */
+					void close()
+					{
+						int fd = this->fd;
+						this->fd = -1;
+						if (::close(fd) == -1) {
+							detail::external_sort_throw("close");
+						}
+					}
+			};
+
+			/*
+			 * A sorted run stored in a temporary file.
+			 */
+			struct external_sort_run_extent
+			{
+					int fd;
+					off_t offset; // in bytes
+					off_t len; // in records
+
+					external_sort_run_extent(int fd, off_t offset, off_t len) KERBAL_NOEXCEPT :
+							fd(fd), offset(offset), len(len)
+					{
+					}
+			};
+
+			/*
+			 * The temporary runs, grouped by the number of merges they have gone through. The runs of one level
+			 * are stored one after another in one file of the level, so the number of the open files only grows
+			 * with the number of the levels, i.e. log(n) to the base fan_out.
+			 * The files are closed (and released since they have been unlinked) on destruction.
+			 */
+			class external_sort_levels: private kerbal::utility::noncopyable
+			{
+				public:
+					std::vector<int> fds;
+					std::vector<off_t> ends; // in bytes
+					std::vector<std::vector<external_sort_run_extent> > runs;
+
+					external_sort_levels()
+					{
+					}
+
+					~external_sort_levels()
+					{
+						for (size_t i = 0; i < fds.size(); ++i) {
+							::close(fds[i]);
+						}
+					}
+
+					size_t size() const KERBAL_NOEXCEPT
+					{
+						return fds.size();
+					}
+			};
+
+			inline
+			int external_sort_open_temp(const char * temp_dir)
+			{
+				if (temp_dir == NULL) {
+					temp_dir = std::getenv("TMPDIR");
+					if (temp_dir == NULL || temp_dir[0] == '\0') {
+						temp_dir = "/tmp";
+					}
+				}
+				std::string path(temp_dir);
+				path += "/kerbal_external_sort_XXXXXX";
+				std::vector<char> templ(path.begin(), path.end());
+				templ.push_back('\0');
+				int fd = ::mkstemp(&templ[0]);
+				if (fd == -1) {
+					detail::external_sort_throw("mkstemp");
+				}
+				::unlink(&templ[0]); // the file is released as soon as fd is closed
+				return fd;
+			}
+
+			inline
+			void external_sort_pread_all(int fd, void * buf, size_t bytes, off_t offset)
+			{
+				char * p = static_cast<char *>(buf);
+				while (bytes > 0) {
+					ssize_t n = ::pread(fd, p, bytes, offset);
+					if (n < 0) {
+						if (errno == EINTR) {
+							continue;
+						}
+						detail::external_sort_throw("pread");
+					}
+					if (n == 0) {
+						errno = EIO; // truncated while being sorted
+						detail::external_sort_throw("pread");
+					}
+					p += n;
+					bytes -= static_cast<size_t>(n);
+					offset += n;
+				}
+			}
+
+			inline
+			void external_sort_write_all(int fd, const void * buf, size_t bytes)
+			{
+				const char * p = static_cast<const char *>(buf);
+				while (bytes > 0) {
+					ssize_t n = ::write(fd, p, bytes);
+					if (n < 0) {
+						if (errno == EINTR) {
+							continue;
+						}
+						detail::external_sort_throw("write");
+					}
+					p += n;
+					bytes -= static_cast<size_t>(n);
+				}
+			}
+
+			/*
+			 * Sequential reader of a run, reads buffer.size() records at a time.
+			 */
+			template <typename Record>
+			class external_sort_run_reader
+			{
+				private:
+					int fd;
+					off_t offset; // in bytes
+					off_t remain; // in records, not read yet
+					std::vector<Record> buffer;
+					size_t pos;
+					size_t len;
+
+					void refill()
+					{
+						pos = 0;
+						len = remain < static_cast<off_t>(buffer.size()) ? static_cast<size_t>(remain) : buffer.size();
+						if (len == 0) {
+							return;
+						}
+						size_t bytes = len * sizeof(Record);
+						detail::external_sort_pread_all(fd, &buffer[0], bytes, offset);
+						offset += static_cast<off_t>(bytes);
+						remain -= static_cast<off_t>(len);
+					}
+
+				public:
+					external_sort_run_reader() :
+							fd(-1), offset(0), remain(0), buffer(), pos(0), len(0)
+					{
+					}
+
+					void open(int fd, off_t offset, off_t records, size_t buffer_records)
+					{
+						this->fd = fd;
+						this->offset = offset;
+						this->remain = records;
+						this->buffer.resize(buffer_records);
+						this->refill();
+					}
+
+					bool empty() const KERBAL_NOEXCEPT
+					{
+						return pos == len;
+					}
+
+					const Record & front() const KERBAL_NOEXCEPT
+					{
+						return buffer[pos];
+					}
+
+					void pop()
+					{
+						++pos;
+						if (pos == len) {
+							this->refill();
+						}
+					}
+			};
+
+			/*
+			 * Input iterator over a run, the default constructed one is the end.
+			 */
+			template <typename Record>
+			class external_sort_run_iterator
+			{
+				private:
+					external_sort_run_reader<Record> * reader;
+
+					bool at_end() const KERBAL_NOEXCEPT
+					{
+						return reader == NULL || reader->empty();
+					}
+
+				public:
+					typedef std::input_iterator_tag		iterator_category;
+					typedef Record						value_type;
+					typedef std::ptrdiff_t				difference_type;
+					typedef const Record *				pointer;
+					typedef const Record &				reference;
+
+					explicit external_sort_run_iterator(external_sort_run_reader<Record> * reader = NULL) KERBAL_NOEXCEPT :
+							reader(reader)
+					{
+					}
+
+					reference operator*() const KERBAL_NOEXCEPT
+					{
+						return reader->front();
+					}
+
+					pointer operator->() const KERBAL_NOEXCEPT
+					{
+						return &reader->front();
+					}
+
+					external_sort_run_iterator & operator++()
+					{
+						reader->pop();
+						return *this;
+					}
+
+					friend bool operator==(const external_sort_run_iterator & lhs, const external_sort_run_iterator & rhs) KERBAL_NOEXCEPT
+					{
+						return lhs.at_end() == rhs.at_end();
+					}
+
+					friend bool operator!=(const external_sort_run_iterator & lhs, const external_sort_run_iterator & rhs) KERBAL_NOEXCEPT
+					{
+						return lhs.at_end() != rhs.at_end();
+					}
+			};
+
+			template <typename Record>
+			class external_sort_run_writer: private kerbal::utility::noncopyable
+			{
+				private:
+					int fd;
+					std::vector<Record> buffer;
+					size_t len;
+
+				public:
+					external_sort_run_writer(int fd, size_t buffer_records) :
+							fd(fd), buffer(buffer_records), len(0)
+					{
+					}
+
+					void push(const Record & record)
+					{
+						buffer[len] = record;
+						++len;
+						if (len == buffer.size()) {
+							this->flush();
+						}
+					}
+
+					void flush()
+					{
+						if (len != 0) {
+							detail::external_sort_write_all(fd, &buffer[0], len * sizeof(Record));
+							len = 0;
+						}
+					}
+			};
+
+			template <typename Record>
+			class external_sort_output_iterator
+			{
+				private:
+					external_sort_run_writer<Record> * writer;
+
+				public:
+					typedef std::output_iterator_tag	iterator_category;
+					typedef void						value_type;
+					typedef void						difference_type;
+					typedef void						pointer;
+					typedef void						reference;
+
+					explicit external_sort_output_iterator(external_sort_run_writer<Record> * writer) KERBAL_NOEXCEPT :
+							writer(writer)
+					{
+					}
+
+					external_sort_output_iterator & operator=(const Record & record)
+					{
+						writer->push(record);
+						return *this;
+					}
+
+					external_sort_output_iterator & operator*() KERBAL_NOEXCEPT
+					{
+						return *this;
+					}
+
+					external_sort_output_iterator & operator++() KERBAL_NOEXCEPT
+					{
+						return *this;
+					}
+
+					external_sort_output_iterator operator++(int) KERBAL_NOEXCEPT
+					{
+						return *this;
+					}
+			};
+
+			template <typename RandomAccessIterator, typename Compare>
+			void external_sort_run(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+									kerbal::type_traits::false_type /*stable*/)
+			{
+				kerbal::algorithm::sort(first, last, cmp);
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			void external_sort_run(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+									kerbal::type_traits::true_type /*stable*/)
+			{
+				kerbal::algorithm::stable_sort(first, last, cmp);
+			}
+
+			/*
+			 * Merge the runs [first, last) to fd.
+			 */
+			template <typename Record, typename Compare, typename Stable>
+			void external_sort_merge(const std::vector<external_sort_run_extent> & runs, size_t first, size_t last, int fd,
+									const external_sort_config & config, Compare & cmp, Stable stable)
+			{
+				typedef external_sort_run_iterator<Record> iterator;
+
+				size_t buffer_records = config.buffer_size / sizeof(Record);
+				if (buffer_records == 0) {
+					buffer_records = 1;
+				}
+
+				std::vector<external_sort_run_reader<Record> > readers(last - first);
+				std::vector<std::pair<iterator, iterator> > ranges;
+				ranges.reserve(last - first);
+				for (size_t i = first; i < last; ++i) {
+					external_sort_run_reader<Record> & reader = readers[i - first];
+					reader.open(runs[i].fd, runs[i].offset, runs[i].len, buffer_records);
+					ranges.push_back(std::make_pair(iterator(&reader), iterator()));
+				}
+
+				external_sort_run_writer<Record> writer(fd, buffer_records);
+				detail::k_way_merge(ranges.begin(), ranges.end(), external_sort_output_iterator<Record>(&writer),
+									cmp, stable);
+				writer.flush();
+			}
+
+			inline
+			void external_sort_ensure_level(external_sort_levels & levels, size_t level, const char * temp_dir)
+			{
+				while (levels.size() <= level) {
+					levels.runs.push_back(std::vector<external_sort_run_extent>());
+					levels.ends.push_back(0);
+					levels.fds.push_back(-1);
+					levels.fds.back() = detail::external_sort_open_temp(temp_dir);
+				}
+			}
+
+			/*
+			 * Merge all the runs of the level into one run appended to the next level.
+			 */
+			template <typename Record, typename Compare, typename Stable>
+			void external_sort_merge_level(external_sort_levels & levels, size_t level,
+											const external_sort_config & config, Compare & cmp, Stable stable)
+			{
+				detail::external_sort_ensure_level(levels, level + 1, config.temp_dir);
+
+				const std::vector<external_sort_run_extent> & runs = levels.runs[level];
+				off_t len = 0;
+				for (size_t i = 0; i < runs.size(); ++i) {
+					len += runs[i].len;
+				}
+				int fd = levels.fds[level + 1];
+				detail::external_sort_merge<Record>(runs, 0, runs.size(), fd, config, cmp, stable);
+				levels.runs[level + 1].push_back(external_sort_run_extent(fd, levels.ends[level + 1], len));
+				levels.ends[level + 1] += len * static_cast<off_t>(sizeof(Record));
+			}
+
+			/*
+			 * Empty the file of the level for reuse, after its runs have been merged.
+			 */
+			inline
+			void external_sort_clear_level(external_sort_levels & levels, size_t level)
+			{
+				int fd = levels.fds[level];
+				if (::ftruncate(fd, 0) == -1) {
+					detail::external_sort_throw("ftruncate");
+				}
+				if (::lseek(fd, 0, SEEK_SET) == -1) {
+					detail::external_sort_throw("lseek");
+				}
+				levels.runs[level].clear();
+				levels.ends[level] = 0;
+			}
+
+			template <typename Record, typename Compare, typename Stable>
+			void external_sort(const char * in_path, const char * out_path, Compare & cmp,
+								const external_sort_config & config, Stable stable)
+			{
+#		if __cplusplus >= 201103L
+				KERBAL_STATIC_ASSERT(std::is_trivially_copyable<Record>::value,
+									"Record must be trivially copyable");
+#		endif
+
+				const size_t fan_out = config.fan_out < 2 ? 2 : config.fan_out;
+				size_t run_records = config.run_size / sizeof(Record);
+				if (run_records == 0) {
+					run_records = 1;
+				}
+
+				external_sort_fd in(::open(in_path, O_RDONLY));
+				if (in.fd == -1) {
+					detail::external_sort_throw("open");
+				}
+				struct stat st;
+				if (::fstat(in.fd, &st) == -1) {
+					detail::external_sort_throw("fstat");
+				}
+				if (st.st_size % static_cast<off_t>(sizeof(Record)) != 0) {
+					errno = EINVAL; // not a file of whole records
+					detail::external_sort_throw("fstat");
+				}
+				const off_t total = st.st_size / static_cast<off_t>(sizeof(Record));
+#		if defined(POSIX_FADV_SEQUENTIAL)
+				::posix_fadvise(in.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#		endif
+
+				/*
+				 * Sort the input run by run. The output is opened after the input has been read completely,
+				 * so that out_path may be the same as in_path.
+				 *
+				 * As soon as a level has fan_out runs, they are merged into one run of the next level, like the
+				 * carry of a counter in base fan_out. The runs of the higher levels are made of the earlier parts
+				 * of the input, and adjacent runs are merged, so that the stable version keeps the order of
+				 * equivalent records.
+				 */
+				external_sort_levels levels;
+				{
+					std::vector<Record> buffer(total < static_cast<off_t>(run_records) ?
+												static_cast<size_t>(total) : run_records);
+					off_t offset = 0;
+					while (offset < total) {
+						size_t len = total - offset < static_cast<off_t>(run_records) ?
+												static_cast<size_t>(total - offset) : run_records;
+						size_t bytes = len * sizeof(Record);
+						detail::external_sort_pread_all(in.fd, &buffer[0], bytes, offset * static_cast<off_t>(sizeof(Record)));
+						offset += static_cast<off_t>(len);
+						detail::external_sort_run(buffer.begin(), buffer.begin() + len, cmp, stable);
+
+						if (offset == total && levels.size() == 0) { // the whole input fits in one run
+							external_sort_fd out(::open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666));
+							if (out.fd == -1) {
+								detail::external_sort_throw("open");
+							}
+							detail::external_sort_write_all(out.fd, &buffer[0], bytes);
+							out.close();
+							return;
+						}
+
+						detail::external_sort_ensure_level(levels, 0, config.temp_dir);
+						detail::external_sort_write_all(levels.fds[0], &buffer[0], bytes);
+						levels.runs[0].push_back(external_sort_run_extent(levels.fds[0], levels.ends[0], static_cast<off_t>(len)));
+						levels.ends[0] += static_cast<off_t>(bytes);
+
+						for (size_t level = 0; levels.runs[level].size() == fan_out; ++level) {
+							detail::external_sort_merge_level<Record>(levels, level, config, cmp, stable);
+							detail::external_sort_clear_level(levels, level);
+						}
+					}
+				}
+
+				/*
+				 * Each level is left with less than fan_out runs. Fold the lowest levels into the next ones
+				 * until there are few enough runs for the last pass, a level of one single run is moved up
+				 * without being copied.
+				 */
+				size_t run_num = 0;
+				for (size_t level = 0; level < levels.size(); ++level) {
+					run_num += levels.runs[level].size();
+				}
+				for (size_t level = 0; run_num > fan_out; ++level) {
+					std::vector<external_sort_run_extent> & runs = levels.runs[level];
+					if (runs.empty()) {
+						continue;
+					}
+					run_num -= runs.size() - 1;
+					if (runs.size() == 1) {
+						detail::external_sort_ensure_level(levels, level + 1, config.temp_dir);
+						levels.runs[level + 1].push_back(runs[0]);
+					} else {
+						detail::external_sort_merge_level<Record>(levels, level, config, cmp, stable);
+					}
+					runs.clear();
+				}
+
+				std::vector<external_sort_run_extent> last_runs;
+				last_runs.reserve(run_num);
+				for (size_t level = levels.size(); level > 0; --level) {
+					const std::vector<external_sort_run_extent> & runs = levels.runs[level - 1];
+					last_runs.insert(last_runs.end(), runs.begin(), runs.end());
+				}
+
+				external_sort_fd out(::open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666));
+				if (out.fd == -1) {
+					detail::external_sort_throw("open");
+				}
+				detail::external_sort_merge<Record>(last_runs, 0, last_runs.size(), out.fd, config, cmp, stable);
+				out.close();
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Sort the file of the records of type Record at in_path and write the result to out_path,
+		 *        which may be the same as in_path.
+		 *
+		 * Runs of config.run_size bytes are sorted in the memory by sort and stored in the temporary files,
+		 * which are merged config.fan_out at a time by the loser tree of k_way_merge, with the sequential
+		 * buffers of config.buffer_size bytes. The runs merged the same number of times share one temporary
+		 * file, so only about log(n / run_size) to the base fan_out files are open at the same time.
+		 * Record must be trivially copyable, the file is treated as an array of them in the native layout.
+		 * Not stable.
+		 *
+		 * @throw external_sort_io_exception if any of the file operations fails
+		 */
+		template <typename Record, typename Compare>
+		void external_sort(const char * in_path, const char * out_path, Compare cmp,
+							const external_sort_config & config)
+		{
+			kerbal::algorithm::detail::external_sort<Record>(in_path, out_path, cmp, config,
+																kerbal::type_traits::false_type());
+		}
+
+		template <typename Record, typename Compare>
+		void external_sort(const char * in_path, const char * out_path, Compare cmp)
+		{
+			kerbal::algorithm::external_sort<Record>(in_path, out_path, cmp, external_sort_config());
+		}
+
+		template <typename Record>
+		void external_sort(const char * in_path, const char * out_path)
+		{
+			kerbal::algorithm::external_sort<Record>(in_path, out_path, std::less<Record>());
+		}
+
+		/**
+		 * @brief Same as external_sort, but the equivalent records keep their order in the input file.
+		 */
+		template <typename Record, typename Compare>
+		void external_stable_sort(const char * in_path, const char * out_path, Compare cmp,
+									const external_sort_config & config)
+		{
+			kerbal::algorithm::detail::external_sort<Record>(in_path, out_path, cmp, config,
+																kerbal::type_traits::true_type());
+		}
+
+		template <typename Record, typename Compare>
+		void external_stable_sort(const char * in_path, const char * out_path, Compare cmp)
+		{
+			kerbal::algorithm::external_stable_sort<Record>(in_path, out_path, cmp, external_sort_config());
+		}
+
+		template <typename Record>
+		void external_stable_sort(const char * in_path, const char * out_path)
+		{
+			kerbal::algorithm::external_stable_sort<Record>(in_path, out_path, std::less<Record>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_EXTERNAL_SORT_HPP
@@ -15,6 +15,9 @@
 #include <kerbal/algorithm/heap.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/iterator/iterator.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
 
 namespace kerbal
 {
@@ -30,6 +33,18 @@ namespace kerbal
 			kerbal::algorithm::sort_heap(first, last, compare);
 		}
 
+		/**
+		 * @brief Heap sort on a heap of ARITY children per node, see the heap algorithms with an arity tag.
+		 */
+		template <typename BidirectionalIterator, typename Compare, size_t ARITY>
+		KERBAL_CONSTEXPR14
+		void heap_sort(BidirectionalIterator first, BidirectionalIterator last, Compare compare,
+						kerbal::type_traits::integral_constant<size_t, ARITY> arity)
+		{
+			kerbal::algorithm::make_heap(first, last, compare, arity);
+			kerbal::algorithm::sort_heap(first, last, compare, arity);
+		}
+
 		template <typename BidirectionalIterator>
 		KERBAL_CONSTEXPR14
 		void heap_sort(BidirectionalIterator first, BidirectionalIterator last)
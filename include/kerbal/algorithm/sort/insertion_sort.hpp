@@ -15,8 +15,16 @@
 #include <kerbal/algorithm/binary_search.hpp>
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+#include <kerbal/type_traits/pointer_deduction.hpp>
+
+#include <cstring>
 
 namespace kerbal
 {
@@ -24,19 +32,76 @@ namespace kerbal
 	namespace algorithm
 	{
 
+		namespace detail
+		{
+
+			/*
+			 * Move *i to insert_pos, and the elements in [insert_pos, i) one step backward.
+			 */
+			template <typename BidirectionalIterator>
+			KERBAL_CONSTEXPR14
+			void insertion_sort_rotate_to(BidirectionalIterator insert_pos, BidirectionalIterator i,
+											kerbal::type_traits::false_type /*relocate by memmove*/)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				value_type value(kerbal::compatibility::to_xvalue(*i));
+				kerbal::algorithm::move_backward(insert_pos, i, kerbal::iterator::next(i));
+				*insert_pos = kerbal::compatibility::to_xvalue(value);
+			}
+
+			template <typename Tp>
+			void insertion_sort_relocate_to(Tp * insert_pos, Tp * i) KERBAL_NOEXCEPT
+			{
+				unsigned char buffer[sizeof(Tp)];
+				std::memcpy(static_cast<void*>(buffer), static_cast<const void*>(i), sizeof(Tp));
+				std::memmove(static_cast<void*>(insert_pos + 1), static_cast<const void*>(insert_pos),
+							(i - insert_pos) * sizeof(Tp));
+				std::memcpy(static_cast<void*>(insert_pos), static_cast<const void*>(buffer), sizeof(Tp));
+			}
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR14
+			void insertion_sort_rotate_to(Tp * insert_pos, Tp * i,
+											kerbal::type_traits::true_type /*relocate by memmove*/)
+			{
+				if (KERBAL_MAY_BE_CONSTANT_EVALUATED()) {
+					detail::insertion_sort_rotate_to(insert_pos, i, kerbal::type_traits::false_type());
+					return;
+				}
+				detail::insertion_sort_relocate_to(insert_pos, i);
+			}
+
+			/*
+			 * The trivially relocatable elements in the raw arrays are shifted as a whole block.
+			 */
+			template <typename BidirectionalIterator>
+			KERBAL_CONSTEXPR14
+			void insertion_sort_rotate_to(BidirectionalIterator insert_pos, BidirectionalIterator i)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef kerbal::type_traits::bool_constant<
+						kerbal::type_traits::is_pointer<iterator>::value &&
+						kerbal::type_traits::is_trivially_relocatable<value_type>::value
+				> relocate_by_memmove;
+
+				detail::insertion_sort_rotate_to(insert_pos, i, relocate_by_memmove());
+			}
+
+		} // namespace detail
+
 		template <typename BidirectionalIterator, typename Compare>
 		KERBAL_CONSTEXPR14
 		void directly_insertion_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
 		{
 			typedef BidirectionalIterator iterator;
-			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
 
 			for (iterator i(first); i != last; ++i) {
 				iterator insert_pos(kerbal::algorithm::upper_bound_backward(first, i, *i, cmp));
 				if (insert_pos != i) {
-					value_type value(kerbal::compatibility::to_xvalue(*i));
-					kerbal::algorithm::move_backward(insert_pos, i, kerbal::iterator::next(i));
-					*insert_pos = kerbal::compatibility::to_xvalue(value);
+					detail::insertion_sort_rotate_to(insert_pos, i);
 				}
 			}
 		}
@@ -57,14 +122,11 @@ namespace kerbal
 		void insertion_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
 		{
 			typedef BidirectionalIterator iterator;
-			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
 
 			for (iterator i(first); i != last; ++i) {
 				iterator insert_pos(kerbal::algorithm::upper_bound(first, i, *i, cmp));
 				if (insert_pos != i) {
-					value_type value(kerbal::compatibility::to_xvalue(*i));
-					kerbal::algorithm::move_backward(insert_pos, i, kerbal::iterator::next(i));
-					*insert_pos = kerbal::compatibility::to_xvalue(value);
+					detail::insertion_sort_rotate_to(insert_pos, i);
 				}
 			}
 		}
@@ -13,14 +13,18 @@
 #define KERBAL_ALGORITHM_SORT_INTRO_SORT_HPP
 
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/sort/detail/pdq_sort_partition.hpp>
 #include <kerbal/algorithm/sort/detail/quick_sort_pivot.hpp>
+#include <kerbal/algorithm/sort/detail/sorting_network.hpp>
 #include <kerbal/algorithm/sort/heap_sort.hpp>
 #include <kerbal/algorithm/sort/insertion_sort.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/container/static_stack.hpp>
 #include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
 
 #include <climits>
+#include <utility>
 
 namespace kerbal
 {
@@ -70,7 +74,7 @@ namespace kerbal
 					last = partition_point;
 				}
 				// dist <= 16
-				kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+				detail::small_sort(first, last, cmp);
 			}
 
 		} // namespace detail
@@ -93,6 +97,156 @@ namespace kerbal
 		}
 
 
+		namespace detail
+		{
+
+			/*
+			 * Pattern-defeating intro sort (pdqsort, Orson Peters).
+			 *
+			 * Compared with intro_sort:
+			 * - if the partition has not swapped anything, both sides are tried by an insertion sort that gives up
+			 *   after a few moves, so that sorted and nearly sorted ranges are finished in linear time
+			 * - if the pivot equals to the element just before the range, all the elements equal to it
+			 *   are split off at once by pdq_sort_partition_left, so that many equal keys don't cost more rounds
+			 * - a highly unbalanced partition shuffles some elements to break the pattern, and only the lg(n)-th
+			 *   bad partition turns to heap sort
+			 * - the block partition is used when Branchless
+			 */
+			template <typename RandomAccessIterator, typename Compare, bool Branchless>
+			void pdq_intro_sort(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp,
+								size_t bad_allowed, bool leftmost,
+								kerbal::type_traits::bool_constant<Branchless> branchless)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef kerbal::type_traits::integral_constant<difference_type, 24> INSERTION_SORT_THRESHOLD;
+				typedef kerbal::type_traits::integral_constant<difference_type, 128> NINTHER_THRESHOLD;
+
+				while (true) {
+					difference_type size(last - first);
+					if (size < INSERTION_SORT_THRESHOLD::value) {
+						detail::small_sort(first, last, cmp);
+						return;
+					}
+
+					// put the median of three (or the pseudo median of nine) at *first
+					difference_type s2(size / 2);
+					if (size > NINTHER_THRESHOLD::value) {
+						detail::pdq_sort3(first, first + s2, last - 1, cmp);
+						detail::pdq_sort3(first + 1, first + (s2 - 1), last - 2, cmp);
+						detail::pdq_sort3(first + 2, first + (s2 + 1), last - 3, cmp);
+						detail::pdq_sort3(first + (s2 - 1), first + s2, first + (s2 + 1), cmp);
+						kerbal::algorithm::iter_swap(first, first + s2);
+					} else {
+						detail::pdq_sort3(first + s2, first, last - 1, cmp);
+					}
+
+					// *(first - 1) is the pivot of some former partition, it is not greater than any one in the range
+					if (!leftmost && !cmp(*(first - 1), *first)) {
+						first = detail::pdq_sort_partition_left(first, last, cmp) + 1;
+						continue;
+					}
+
+					std::pair<iterator, bool> part(detail::pdq_sort_partition_right(first, last, cmp, branchless));
+					iterator pivot_pos(part.first);
+					bool already_partitioned = part.second;
+
+					difference_type l_size(pivot_pos - first);
+					difference_type r_size(last - (pivot_pos + 1));
+					bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+					if (highly_unbalanced) {
+						if (--bad_allowed == 0) {
+							kerbal::algorithm::heap_sort(first, last, cmp);
+							return;
+						}
+
+						if (l_size >= INSERTION_SORT_THRESHOLD::value) {
+							kerbal::algorithm::iter_swap(first, first + l_size / 4);
+							kerbal::algorithm::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+							if (l_size > NINTHER_THRESHOLD::value) {
+								kerbal::algorithm::iter_swap(first + 1, first + (l_size / 4 + 1));
+								kerbal::algorithm::iter_swap(first + 2, first + (l_size / 4 + 2));
+								kerbal::algorithm::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+								kerbal::algorithm::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+							}
+						}
+
+						if (r_size >= INSERTION_SORT_THRESHOLD::value) {
+							kerbal::algorithm::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+							kerbal::algorithm::iter_swap(last - 1, last - r_size / 4);
+							if (r_size > NINTHER_THRESHOLD::value) {
+								kerbal::algorithm::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+								kerbal::algorithm::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+								kerbal::algorithm::iter_swap(last - 2, last - (1 + r_size / 4));
+								kerbal::algorithm::iter_swap(last - 3, last - (2 + r_size / 4));
+							}
+						}
+					} else {
+						if (already_partitioned &&
+								detail::pdq_sort_partial_insertion_sort(first, pivot_pos, cmp) &&
+								detail::pdq_sort_partial_insertion_sort(pivot_pos + 1, last, cmp)) {
+							return;
+						}
+					}
+
+					detail::pdq_intro_sort(first, pivot_pos, cmp, bad_allowed, leftmost, branchless);
+					first = pivot_pos + 1;
+					leftmost = false;
+				}
+			}
+
+			template <typename BidirectionalIterator, typename Compare>
+			void pdq_intro_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+								std::bidirectional_iterator_tag)
+			{
+				kerbal::algorithm::intro_sort(first, last, cmp);
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			void pdq_intro_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+								std::random_access_iterator_tag)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+				if (first == last) {
+					return;
+				}
+
+				detail::pdq_intro_sort(first, last, cmp,
+									detail::lg(kerbal::iterator::distance(first, last)) + 1, true,
+									kerbal::type_traits::bool_constant<
+											detail::pdq_sort_is_branchless<value_type, Compare>::value
+									>());
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief The opt-in pattern-defeating mode of intro_sort.
+		 *
+		 * Unlike intro_sort, sorted, reversed, nearly sorted ranges and ranges with many equal keys are sorted
+		 * in linear time or close to it, and the comparison of arithmetic types by std::less/std::greater goes
+		 * through a branchless block partition. Bidirectional iterators are sorted by intro_sort.
+		 * Not stable.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		void pdq_intro_sort(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
+		{
+			detail::pdq_intro_sort(first, last, cmp, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename BidirectionalIterator>
+		void pdq_intro_sort(BidirectionalIterator first, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::pdq_intro_sort(first, last, std::less<value_type>());
+		}
+
+
 		namespace detail
 		{
 
@@ -134,7 +288,7 @@ namespace kerbal
 
 				while (depth_limit != 0) {
 					if (kerbal::iterator::distance_less_than(first, last, 16)) {
-						kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+						detail::small_sort(first, last, cmp);
 						break;
 					}
 
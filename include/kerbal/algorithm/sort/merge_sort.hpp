@@ -17,10 +17,13 @@
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 
+#include <cstddef>
 #include <memory>
 
 #include <kerbal/algorithm/sort/detail/merge_sort_merge.hpp>
+#include <kerbal/algorithm/sort/detail/sorting_network.hpp>
 
 namespace kerbal
 {
@@ -28,6 +31,36 @@ namespace kerbal
 	namespace algorithm
 	{
 
+		namespace detail
+		{
+
+			template <typename ForwardIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			bool merge_sort_n_small_size(ForwardIterator /*first*/,
+										typename kerbal::iterator::iterator_traits<ForwardIterator>::difference_type /*len*/,
+										Compare & /*cmp*/, kerbal::type_traits::integral_constant<size_t, 0>)
+			{
+				return false;
+			}
+
+			/*
+			 * the integers sorted by the sorting network are indistinguishable from the ones stably sorted
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			bool merge_sort_n_small_size(RandomAccessIterator first,
+										typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+										Compare & cmp, kerbal::type_traits::integral_constant<size_t, 1> policy)
+			{
+				if (len > 32) {
+					return false;
+				}
+				detail::small_sort(first, first + len, cmp, policy);
+				return true;
+			}
+
+		} // namespace detail
+
 		/*
 		 * return first + len
 		 */
@@ -54,6 +87,10 @@ namespace kerbal
 				}
 				return kerbal::iterator::next(i);
 			}
+			if (detail::merge_sort_n_small_size(first, len, cmp,
+					typename detail::sorting_network_policy_helper<iterator, Compare>::stable_policy())) {
+				return kerbal::iterator::next(first, len);
+			}
 
 			difference_type first_half_len = len / 2;
 			iterator mid(kerbal::algorithm::merge_sort_n_afford_buffer(first, first_half_len, buffer, cmp));
@@ -0,0 +1,221 @@
+/**
+ * @file       msd_radix_sort.hpp
+ * @brief
+ * @date       2020-08-25
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_MSD_RADIX_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_MSD_RADIX_SORT_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/algorithm/sort/radix_sort.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <climits>
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename Key, typename Extract, typename Order>
+			struct msd_radix_sort_compare
+			{
+					Extract & extract;
+
+					explicit msd_radix_sort_compare(Extract & extract) KERBAL_NOEXCEPT :
+							extract(extract)
+					{
+					}
+
+					template <typename Tp>
+					bool operator()(const Tp & lhs, const Tp & rhs) const
+					{
+						return detail::radix_sort_ordered_key<Key>(extract(lhs), Order()) <
+								detail::radix_sort_ordered_key<Key>(extract(rhs), Order());
+					}
+			};
+
+			/*
+			 * American flag sort: permute the elements to their buckets of the digit of the round
+			 * by cycle leader swaps, then recurse into each bucket with the next lower digit.
+			 */
+			template <typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			void msd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+								Extract & extract, Order order,
+								kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width,
+								size_t round)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef typename radix_sort_extract_key_type<Extract, value_type>::type key_type;
+				typedef radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+				typedef typename traits::BUCKETS_NUM BUCKETS_NUM;
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+
+				if (len <= 16) {
+					kerbal::algorithm::directly_insertion_sort(first, last,
+							msd_radix_sort_compare<key_type, Extract, Order>(extract));
+					return;
+				}
+
+				radix_sort_counter<size_t, BUCKETS_NUM::value> counter;
+				size_t * const cnt = counter.data();
+				while (true) {
+					for (iterator it(first); it != last; ++it) {
+						++cnt[traits::digit(detail::radix_sort_ordered_key<key_type>(extract(*it), order), round)];
+					}
+
+					if (cnt[traits::digit(detail::radix_sort_ordered_key<key_type>(extract(*first), order), round)] !=
+																									static_cast<size_t>(len)) {
+						break;
+					}
+
+					// all the elements share the same digit in this round
+					if (round == 0) {
+						return;
+					}
+					--round;
+					for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
+						cnt[i] = 0;
+					}
+				}
+
+				radix_sort_counter<difference_type, BUCKETS_NUM::value> head_counter;
+				radix_sort_counter<difference_type, BUCKETS_NUM::value> tail_counter;
+				difference_type * const head = head_counter.data();
+				difference_type * const tail = tail_counter.data();
+				{
+					difference_type sum = 0;
+					for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
+						head[i] = sum;
+						sum += static_cast<difference_type>(cnt[i]);
+						tail[i] = sum;
+					}
+				}
+
+				for (size_t bucket_id = 0; bucket_id < BUCKETS_NUM::value; ++bucket_id) {
+					while (head[bucket_id] != tail[bucket_id]) {
+						iterator leader(kerbal::iterator::next(first, head[bucket_id]));
+						size_t digit = traits::digit(detail::radix_sort_ordered_key<key_type>(extract(*leader), order), round);
+						if (digit == bucket_id) {
+							++head[bucket_id];
+							continue;
+						}
+						value_type value(kerbal::compatibility::to_xvalue(*leader));
+						do {
+							iterator target(kerbal::iterator::next(first, head[digit]));
+							++head[digit];
+							kerbal::algorithm::swap(value, *target);
+							digit = traits::digit(detail::radix_sort_ordered_key<key_type>(extract(value), order), round);
+						} while (digit != bucket_id);
+						*leader = kerbal::compatibility::to_xvalue(value);
+						++head[bucket_id];
+					}
+				}
+
+				if (round == 0) {
+					return;
+				}
+
+				iterator bucket_first(first);
+				for (size_t bucket_id = 0; bucket_id < BUCKETS_NUM::value; ++bucket_id) {
+					if (cnt[bucket_id] == 0) {
+						continue;
+					}
+					iterator bucket_last(kerbal::iterator::next(bucket_first, static_cast<difference_type>(cnt[bucket_id])));
+					if (cnt[bucket_id] > 1) {
+						detail::msd_radix_sort(bucket_first, bucket_last, extract, order, radix_bit_width, round - 1);
+					}
+					bucket_first = bucket_last;
+				}
+			}
+
+		} // namespace detail
+
+		/*
+		 * In-place MSD radix sort (American flag sort) by the keys extracted by `extract`.
+		 * Needs O(2^RADIX_BIT_WIDTH) extra memory per recursion level and at most one level per digit of the key.
+		 * Not stable.
+		 */
+		template <typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void msd_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract,
+									Order /*order*/, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef typename detail::radix_sort_extract_key_type<Extract, value_type>::type key_type;
+			typedef detail::radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+
+			KERBAL_STATIC_ASSERT(is_radix_sort_acceptable_type<key_type>::value,
+								"msd_radix_sort only accepts integral type or IEEE 754 float/double key");
+
+			if (first == last) {
+				return;
+			}
+
+			kerbal::algorithm::detail::msd_radix_sort(first, last, extract,
+													kerbal::type_traits::bool_constant<Order::value>(), radix_bit_width,
+													traits::ROUNDS::value - 1);
+		}
+
+		template <typename RandomAccessIterator, typename Extract, typename Order>
+		void msd_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract, Order order)
+		{
+			kerbal::algorithm::msd_radix_sort_by_key(first, last, extract, order,
+													kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename Extract>
+		void msd_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract)
+		{
+			kerbal::algorithm::msd_radix_sort_by_key(first, last, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename Order, size_t RADIX_BIT_WIDTH>
+		void msd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+							Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::msd_radix_sort_by_key(first, last, detail::radix_sort_identity_extract<value_type>(),
+													order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename Order>
+		void msd_radix_sort(RandomAccessIterator first, RandomAccessIterator last, Order order)
+		{
+			kerbal::algorithm::msd_radix_sort(first, last, order,
+											kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator>
+		void msd_radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			kerbal::algorithm::msd_radix_sort(first, last, kerbal::type_traits::false_type());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_MSD_RADIX_SORT_HPP
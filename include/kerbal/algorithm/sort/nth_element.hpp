@@ -0,0 +1,214 @@
+/**
+ * @file       nth_element.hpp
+ * @brief
+ * @date       2020-08-31
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
+#define KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/sort/detail/quick_sort_pivot.hpp>
+#include <kerbal/algorithm/sort/detail/sorting_network.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/algorithm/sort/intro_sort.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Partition [first, last) by the pivot placed at back, which is prev(last).
+			 * Return the position where the pivot ends up, elements before it are not greater than the pivot
+			 * and elements after it are not less than the pivot.
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			BidirectionalIterator
+			nth_element_partition(BidirectionalIterator first, BidirectionalIterator back, Compare & cmp)
+			{
+				typedef BidirectionalIterator iterator;
+
+				iterator partition_point(detail::quick_sort_partition(first, back, *back, cmp));
+				if (partition_point != back) {
+					if (cmp(*back, *partition_point)) {
+						kerbal::algorithm::iter_swap(back, partition_point);
+					}
+				}
+				return partition_point;
+			}
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void nth_element_median_of_medians(BidirectionalIterator first, BidirectionalIterator last,
+						typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type k,
+						typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type len,
+						Compare & cmp);
+
+			/*
+			 * Gather the medians of each group of 5 elements to the front of the len elements from first and select the median of
+			 * them, which is guaranteed to be greater than or equal to at least 3/10 of the elements and
+			 * less than or equal to at least 3/10 of the elements.
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			BidirectionalIterator
+			nth_element_median_of_medians_pivot(BidirectionalIterator first,
+						typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type len,
+						Compare & cmp)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				iterator medians_last(first);
+				difference_type medians_len = 0;
+				iterator group_first(first);
+				while (len > 0) {
+					difference_type group_len = len < 5 ? len : 5;
+					iterator group_last(kerbal::iterator::next(group_first, group_len));
+					kerbal::algorithm::directly_insertion_sort(group_first, group_last, cmp);
+					kerbal::algorithm::iter_swap(medians_last, kerbal::iterator::next(group_first, (group_len - 1) / 2));
+					++medians_last;
+					++medians_len;
+					group_first = group_last;
+					len -= group_len;
+				}
+
+				difference_type mid = (medians_len - 1) / 2;
+				detail::nth_element_median_of_medians(first, medians_last, mid, medians_len, cmp);
+				return kerbal::iterator::next(first, mid);
+			}
+
+			/*
+			 * Select the k-th element of [first, last) in guaranteed linear time.
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void nth_element_median_of_medians(BidirectionalIterator first, BidirectionalIterator last,
+						typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type k,
+						typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type len,
+						Compare & cmp)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				while (len > 16) {
+					iterator back(kerbal::iterator::prev(last));
+					kerbal::algorithm::iter_swap(detail::nth_element_median_of_medians_pivot(first, len, cmp), back);
+					iterator partition_point(detail::nth_element_partition(first, back, cmp));
+					difference_type idx(kerbal::iterator::distance(first, partition_point));
+					if (k == idx) {
+						return;
+					}
+					if (k < idx) {
+						last = partition_point;
+						len = idx;
+					} else {
+						first = kerbal::iterator::next(partition_point);
+						k -= idx + 1;
+						len -= idx + 1;
+					}
+				}
+				detail::small_sort(first, last, cmp);
+			}
+
+			/*
+			 * Introselect: quick select by the median of three pivot as what intro_sort does, turns to
+			 * the median of medians once the range is not halved within HALVING_STEPS partition steps.
+			 * Each such period either halves the range or is the last one, so the partitioned lengths sum
+			 * up to O(n) and the worst case is still O(n).
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void nth_element(BidirectionalIterator first, BidirectionalIterator last,
+							typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type k,
+							Compare & cmp)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const size_t HALVING_STEPS = 3;
+
+				difference_type len(kerbal::iterator::distance(first, last));
+				difference_type period_len(len); // length of the range at the beginning of the period
+				size_t steps = 0;
+				while (len > 16) {
+					if (steps == HALVING_STEPS) {
+						if (len > period_len / 2) {
+							detail::nth_element_median_of_medians(first, last, k, len, cmp);
+							return;
+						}
+						period_len = len;
+						steps = 0;
+					}
+					++steps;
+
+					iterator back(kerbal::iterator::prev(last));
+					detail::quick_sort_select_pivot(first, back, cmp);
+					iterator partition_point(detail::nth_element_partition(first, back, cmp));
+					difference_type idx(kerbal::iterator::distance(first, partition_point));
+					if (k == idx) {
+						return;
+					}
+					if (k < idx) {
+						last = partition_point;
+						len = idx;
+					} else {
+						first = kerbal::iterator::next(partition_point);
+						k -= idx + 1;
+						len -= idx + 1;
+					}
+				}
+				detail::small_sort(first, last, cmp);
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Rearrange [first, last) so that *nth is the element which would be there if [first, last) was
+		 *        sorted, no element in [first, nth) is greater than *nth and no element in (nth, last) is less
+		 *        than *nth.
+		 *
+		 * O(n) comparisons on average and in the worst case. Not stable.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void nth_element(BidirectionalIterator first, BidirectionalIterator nth, BidirectionalIterator last,
+						Compare cmp)
+		{
+			if (nth == last) {
+				return;
+			}
+			detail::nth_element(first, last, kerbal::iterator::distance(first, nth), cmp);
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void nth_element(BidirectionalIterator first, BidirectionalIterator nth, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::nth_element(first, nth, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
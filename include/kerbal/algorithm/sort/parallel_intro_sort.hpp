@@ -0,0 +1,293 @@
+/**
+ * @file       parallel_intro_sort.hpp
+ * @brief
+ * @date       2020-08-23
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARALLEL_INTRO_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARALLEL_INTRO_SORT_HPP
+
+#include <kerbal/openmp/disable_warning.hpp>
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/sort/detail/quick_sort_pivot.hpp>
+#include <kerbal/algorithm/sort/heap_sort.hpp>
+#include <kerbal/algorithm/sort/intro_sort.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#	include <omp.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename RandomAccessIterator>
+			struct parallel_intro_sort_default_grain:
+					kerbal::type_traits::integral_constant<size_t, 1 << 14>
+			{
+			};
+
+			/*
+			 * partition [first, last) with a range of length over this threshold by all threads of the team
+			 */
+			template <typename RandomAccessIterator>
+			struct parallel_intro_sort_parallel_partition_threshold:
+					kerbal::type_traits::integral_constant<size_t, 1 << 18>
+			{
+			};
+
+			inline
+			size_t parallel_intro_sort_team_size() KERBAL_NOEXCEPT
+			{
+#	if defined(_OPENMP)
+				return static_cast<size_t>(::omp_get_num_threads());
+#	else
+				return 1;
+#	endif
+			}
+
+			/*
+			 * swap the k-th element of misplaced_left with the k-th element of misplaced_right, for k in [k_first, k_last)
+			 */
+			template <typename RandomAccessIterator, typename Difference>
+			void parallel_partition_swap_misplaced(RandomAccessIterator first,
+					const std::vector<std::pair<Difference, Difference> > * misplaced_left,
+					const std::vector<std::pair<Difference, Difference> > * misplaced_right,
+					Difference k_first, Difference k_last)
+			{
+				typedef Difference difference_type;
+
+				size_t i = 0;
+				difference_type left_pos = 0;
+				{
+					difference_type skip = k_first;
+					while (skip >= (*misplaced_left)[i].second - (*misplaced_left)[i].first) {
+						skip -= (*misplaced_left)[i].second - (*misplaced_left)[i].first;
+						++i;
+					}
+					left_pos = (*misplaced_left)[i].first + skip;
+				}
+
+				size_t j = 0;
+				difference_type right_pos = 0;
+				{
+					difference_type skip = k_first;
+					while (skip >= (*misplaced_right)[j].second - (*misplaced_right)[j].first) {
+						skip -= (*misplaced_right)[j].second - (*misplaced_right)[j].first;
+						++j;
+					}
+					right_pos = (*misplaced_right)[j].first + skip;
+				}
+
+				for (difference_type k = k_first; k != k_last; ++k) {
+					if (left_pos == (*misplaced_left)[i].second) {
+						++i;
+						left_pos = (*misplaced_left)[i].first;
+					}
+					if (right_pos == (*misplaced_right)[j].second) {
+						++j;
+						right_pos = (*misplaced_right)[j].first;
+					}
+					kerbal::algorithm::iter_swap(first + left_pos, first + right_pos);
+					++left_pos;
+					++right_pos;
+				}
+			}
+
+			/*
+			 * Same post condition as quick_sort_partition, but the range is split into one block per thread.
+			 * Each block is partitioned by its own task, then the elements which lie on the wrong side of the
+			 * global partition point are swapped pairwise, again by one task per block.
+			 */
+			template <typename RandomAccessIterator, typename Tp, typename Compare>
+			RandomAccessIterator
+			parallel_quick_sort_partition(RandomAccessIterator first, RandomAccessIterator last,
+										const Tp & pivot, Compare & cmp, size_t blocks)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef std::pair<difference_type, difference_type> interval;
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const difference_type block_num(static_cast<difference_type>(blocks));
+
+				std::vector<difference_type> partition_points(blocks);
+				difference_type * const pp = &partition_points[0];
+				const Tp * const ppivot = &pivot;
+				Compare * const pcmp = &cmp;
+
+				for (difference_type i = 0; i < block_num; ++i) {
+#					pragma omp task firstprivate(i, first, len, block_num, pp, ppivot, pcmp)
+					{
+						iterator block_first(first + len * i / block_num);
+						iterator block_last(first + len * (i + 1) / block_num);
+						pp[i] = kerbal::iterator::distance(first,
+								kerbal::algorithm::detail::quick_sort_partition(block_first, block_last, *ppivot, *pcmp));
+					}
+				}
+#				pragma omp taskwait
+
+				difference_type split = 0;
+				for (difference_type i = 0; i < block_num; ++i) {
+					split += pp[i] - len * i / block_num;
+				}
+
+				std::vector<interval> misplaced_left;
+				std::vector<interval> misplaced_right;
+				difference_type misplaced = 0;
+				for (difference_type i = 0; i < block_num; ++i) {
+					difference_type block_first = len * i / block_num;
+					difference_type block_last = len * (i + 1) / block_num;
+					if (pp[i] < split) { // ge part of this block intersects with [0, split)
+						difference_type e = block_last < split ? block_last : split;
+						if (pp[i] != e) {
+							misplaced_left.push_back(interval(pp[i], e));
+							misplaced += e - pp[i];
+						}
+					} else if (split < pp[i]) { // le part of this block intersects with [split, len)
+						difference_type b = split < block_first ? block_first : split;
+						if (b != pp[i]) {
+							misplaced_right.push_back(interval(b, pp[i]));
+						}
+					}
+				}
+
+				if (misplaced != 0) {
+					const std::vector<interval> * const pml = &misplaced_left;
+					const std::vector<interval> * const pmr = &misplaced_right;
+					for (difference_type i = 0; i < block_num; ++i) {
+						difference_type k_first = misplaced * i / block_num;
+						difference_type k_last = misplaced * (i + 1) / block_num;
+						if (k_first != k_last) {
+#							pragma omp task firstprivate(first, pml, pmr, k_first, k_last)
+							kerbal::algorithm::detail::parallel_partition_swap_misplaced(first, pml, pmr, k_first, k_last);
+						}
+					}
+#					pragma omp taskwait
+				}
+
+				return first + split;
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			void parallel_intro_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, size_t depth_limit,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type grain)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				while (kerbal::iterator::distance_greater_than(first, last, grain)) {
+					if (depth_limit == 0) {
+						kerbal::algorithm::heap_sort(first, last, cmp);
+						return;
+					}
+
+					--depth_limit;
+
+					iterator back(kerbal::iterator::prev(last));
+					detail::quick_sort_select_pivot(first, back, cmp);
+
+					size_t team_size = detail::parallel_intro_sort_team_size();
+					iterator partition_point(
+							(team_size > 1 && kerbal::iterator::distance_greater_than(first, back, static_cast<difference_type>(
+									detail::parallel_intro_sort_parallel_partition_threshold<iterator>::value))) ?
+							detail::parallel_quick_sort_partition(first, back, *back, cmp, team_size) :
+							detail::quick_sort_partition(first, back, *back, cmp)
+					);
+
+					if (partition_point != back) {
+						if (cmp(*back, *partition_point)) {
+							kerbal::algorithm::iter_swap(back, partition_point);
+						}
+						iterator right_first(kerbal::iterator::next(partition_point));
+#						pragma omp task firstprivate(right_first, last, cmp, depth_limit, grain)
+						detail::parallel_intro_sort(right_first, last, cmp, depth_limit, grain);
+					}
+					last = partition_point;
+				}
+				detail::intro_sort(first, last, cmp, depth_limit);
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Sort [first, last) by the openMP threads.
+		 *
+		 * Partitions longer than grain are handed to new tasks, the shorter ones are finished by the serial intro_sort.
+		 * When called outside of any parallel region, a new one is opened; otherwise the tasks are spawned
+		 * into the current team.
+		 *
+		 * @warning Inside a parallel region, it must be called by one thread of the team only, e.g. in a single or
+		 *          master construct or in a task, since each call sorts the whole range. It is not wrapped in a
+		 *          single construct itself, which would be ill-formed when nested in those regions.
+		 */
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_intro_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type grain)
+		{
+			size_t depth_limit = 2 * detail::lg(kerbal::iterator::distance(first, last));
+			if (grain < 16) {
+				grain = 16;
+			}
+
+#	if defined(_OPENMP)
+			if (::omp_in_parallel()) { // called by one thread of the team, see the warning above
+#				pragma omp taskgroup
+				{
+					detail::parallel_intro_sort(first, last, cmp, depth_limit, grain);
+				}
+				return;
+			}
+#	endif
+
+#			pragma omp parallel
+			{
+#				pragma omp single
+				{
+					detail::parallel_intro_sort(first, last, cmp, depth_limit, grain);
+				}
+			}
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_intro_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			kerbal::algorithm::parallel_intro_sort(first, last, cmp,
+					detail::parallel_intro_sort_default_grain<iterator>::value);
+		}
+
+		template <typename RandomAccessIterator>
+		void parallel_intro_sort(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::parallel_intro_sort(first, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARALLEL_INTRO_SORT_HPP
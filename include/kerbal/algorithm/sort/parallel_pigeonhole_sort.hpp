@@ -0,0 +1,243 @@
+/**
+ * @file       parallel_pigeonhole_sort.hpp
+ * @brief
+ * @date       2020-09-05
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARALLEL_PIGEONHOLE_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARALLEL_PIGEONHOLE_SORT_HPP
+
+#include <kerbal/openmp/disable_warning.hpp>
+
+#include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/pointer_deduction.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(_OPENMP)
+#	include <omp.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * ranges not longer than this threshold are sorted by the serial pigeonhole sort
+			 */
+			template <typename RandomAccessIterator>
+			struct parallel_pigeonhole_sort_serial_threshold:
+					kerbal::type_traits::integral_constant<size_t, 1 << 16>
+			{
+			};
+
+			inline
+			size_t parallel_pigeonhole_sort_chunk_num() KERBAL_NOEXCEPT
+			{
+#	if defined(_OPENMP)
+				return static_cast<size_t>(::omp_get_max_threads());
+#	else
+				return 1;
+#	endif
+			}
+
+			/*
+			 * The k-th bucket to be written back. The buckets are indexed by the value casted to unsigned,
+			 * so for the signed types the negative ones are at the upper half.
+			 */
+			template <size_t BUCKETS_NUM>
+			KERBAL_CONSTEXPR
+			size_t parallel_pigeonhole_sort_bucket_at(size_t k,
+													kerbal::type_traits::false_type /*asc*/,
+													kerbal::type_traits::false_type /*unsigned*/) KERBAL_NOEXCEPT
+			{
+				return k;
+			}
+
+			template <size_t BUCKETS_NUM>
+			KERBAL_CONSTEXPR
+			size_t parallel_pigeonhole_sort_bucket_at(size_t k,
+													kerbal::type_traits::true_type /*desc*/,
+													kerbal::type_traits::false_type /*unsigned*/) KERBAL_NOEXCEPT
+			{
+				return BUCKETS_NUM - 1 - k;
+			}
+
+			template <size_t BUCKETS_NUM>
+			KERBAL_CONSTEXPR
+			size_t parallel_pigeonhole_sort_bucket_at(size_t k,
+													kerbal::type_traits::false_type /*asc*/,
+													kerbal::type_traits::true_type /*signed*/) KERBAL_NOEXCEPT
+			{
+				return (k + BUCKETS_NUM / 2) % BUCKETS_NUM;
+			}
+
+			template <size_t BUCKETS_NUM>
+			KERBAL_CONSTEXPR
+			size_t parallel_pigeonhole_sort_bucket_at(size_t k,
+													kerbal::type_traits::true_type /*desc*/,
+													kerbal::type_traits::true_type /*signed*/) KERBAL_NOEXCEPT
+			{
+				return (BUCKETS_NUM + BUCKETS_NUM / 2 - 1 - k) % BUCKETS_NUM;
+			}
+
+			template <typename RandomAccessIterator>
+			struct parallel_pigeonhole_sort_is_memset_fillable:
+					kerbal::type_traits::bool_constant<
+							kerbal::type_traits::is_pointer<RandomAccessIterator>::value &&
+							sizeof(typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type) == 1
+					>
+			{
+			};
+
+			template <typename RandomAccessIterator>
+			void parallel_pigeonhole_sort_fill_n(RandomAccessIterator first, size_t n,
+												typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type current,
+												kerbal::type_traits::false_type /*memset fillable*/)
+			{
+				detail::pigeonhole_sort_back_fill_n(first, n, current);
+			}
+
+			template <typename RandomAccessIterator>
+			void parallel_pigeonhole_sort_fill_n(RandomAccessIterator first, size_t n,
+												typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type current,
+												kerbal::type_traits::true_type /*memset fillable*/)
+			{
+				unsigned char byte;
+				std::memcpy(&byte, &current, 1);
+				std::memset(first, byte, n);
+			}
+
+			template <typename RandomAccessIterator>
+			void parallel_pigeonhole_sort_fill_n(RandomAccessIterator first, size_t n,
+												typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type current)
+			{
+				detail::parallel_pigeonhole_sort_fill_n(first, n, current,
+														parallel_pigeonhole_sort_is_memset_fillable<RandomAccessIterator>());
+			}
+
+			/*
+			 * Parallel pigeonhole sort.
+			 *
+			 * The range is split into `chunk_num` chunks, every chunk counts the values of itself into its own
+			 * count array at the same time, then the count arrays are reduced bucket by bucket. The exclusive
+			 * prefix sum of the buckets in the written back order gives the destination of each bucket, and
+			 * [first, last) is split into `chunk_num` equal parts again, each of which is written back by one
+			 * thread with the buckets overlapping it.
+			 */
+			template <typename RandomAccessIterator, typename Order>
+			void parallel_pigeonhole_sort(RandomAccessIterator first, RandomAccessIterator last, Order order,
+										size_t chunk_num)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef kerbal::type_traits::integral_constant<size_t, cnt_array_size<iterator>::value> BUCKETS_NUM;
+				typedef kerbal::type_traits::is_signed<value_type> is_signed;
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const difference_type chunks(static_cast<difference_type>(chunk_num));
+
+				if (chunk_num < 2 || len <= static_cast<difference_type>(
+						parallel_pigeonhole_sort_serial_threshold<iterator>::value)) {
+					kerbal::algorithm::pigeonhole_sort(first, last, order);
+					return;
+				}
+
+				// cnt[chunk * BUCKETS + bucket]
+				std::vector<size_t> cnt(chunk_num * BUCKETS_NUM::value, 0);
+				size_t * const pcnt = &cnt[0];
+
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					detail::pigeonhole_sort_fill(first + len * i / chunks, first + len * (i + 1) / chunks,
+												pcnt + i * BUCKETS_NUM::value);
+				}
+
+				const difference_type buckets(static_cast<difference_type>(BUCKETS_NUM::value));
+
+#				pragma omp parallel for schedule(static)
+				for (difference_type j = 0; j < buckets; ++j) {
+					size_t sum = 0;
+					for (size_t i = 0; i < chunk_num; ++i) {
+						sum += pcnt[i * BUCKETS_NUM::value + j];
+					}
+					pcnt[j] = sum;
+				}
+
+				// offset[k]: where the k-th written back bucket starts
+				std::vector<size_t> offset(BUCKETS_NUM::value + 1);
+				offset[0] = 0;
+				for (size_t k = 0; k < BUCKETS_NUM::value; ++k) {
+					offset[k + 1] = offset[k] + pcnt[detail::parallel_pigeonhole_sort_bucket_at<BUCKETS_NUM::value>(k, order, is_signed())];
+				}
+				const size_t * const poffset = &offset[0];
+
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					const size_t part_first = static_cast<size_t>(len * i / chunks);
+					const size_t part_last = static_cast<size_t>(len * (i + 1) / chunks);
+					size_t k = 0;
+					while (poffset[k + 1] <= part_first) {
+						++k;
+					}
+					while (k < BUCKETS_NUM::value && poffset[k] < part_last) {
+						size_t lo = poffset[k] < part_first ? part_first : poffset[k];
+						size_t hi = poffset[k + 1] < part_last ? poffset[k + 1] : part_last;
+						value_type current(static_cast<value_type>(
+								detail::parallel_pigeonhole_sort_bucket_at<BUCKETS_NUM::value>(k, order, is_signed())));
+						detail::parallel_pigeonhole_sort_fill_n(first + static_cast<difference_type>(lo), hi - lo, current);
+						++k;
+					}
+				}
+			}
+
+		} // namespace detail
+
+		/*
+		 * Same as pigeonhole_sort, but both the counting and the writing back are shared by the openMP threads.
+		 * The byte types in the arrays are written back by memset.
+		 */
+		template <typename RandomAccessIterator, typename Order>
+		void parallel_pigeonhole_sort(RandomAccessIterator first, RandomAccessIterator last, Order /*order*/)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			KERBAL_STATIC_ASSERT(is_pigeonhole_sort_acceptable_type<value_type>::value,
+								 "pigeonhole sort only accept bool type or integer with bit width <= 16");
+
+			detail::parallel_pigeonhole_sort(first, last, kerbal::type_traits::bool_constant<Order::value>(),
+											detail::parallel_pigeonhole_sort_chunk_num());
+		}
+
+		template <typename RandomAccessIterator>
+		void parallel_pigeonhole_sort(RandomAccessIterator first, RandomAccessIterator last) // default: asc
+		{
+			kerbal::algorithm::parallel_pigeonhole_sort(first, last, kerbal::type_traits::false_type());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARALLEL_PIGEONHOLE_SORT_HPP
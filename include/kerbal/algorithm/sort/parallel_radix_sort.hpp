@@ -0,0 +1,413 @@
+/**
+ * @file       parallel_radix_sort.hpp
+ * @brief
+ * @date       2020-08-26
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARALLEL_RADIX_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARALLEL_RADIX_SORT_HPP
+
+#include <kerbal/openmp/disable_warning.hpp>
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/sort/radix_sort.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#if defined(_OPENMP)
+#	include <omp.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * ranges not longer than this threshold are sorted by the serial lsd radix sort
+			 */
+			template <typename RandomAccessIterator>
+			struct parallel_radix_sort_serial_threshold:
+					kerbal::type_traits::integral_constant<size_t, 1 << 16>
+			{
+			};
+
+			inline
+			size_t parallel_radix_sort_chunk_num() KERBAL_NOEXCEPT
+			{
+#	if defined(_OPENMP)
+				return static_cast<size_t>(::omp_get_max_threads());
+#	else
+				return 1;
+#	endif
+			}
+
+			template <typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			void parallel_lsd_radix_sort_count(RandomAccessIterator first, RandomAccessIterator last,
+												size_t cnt[], size_t round, Extract & extract, Order order,
+												kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename radix_sort_extract_key_type<Extract, value_type>::type key_type;
+				typedef radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+
+				while (first != last) {
+					++cnt[traits::digit(detail::radix_sort_ordered_key<key_type>(extract(*first), order), round)];
+					++first;
+				}
+			}
+
+			/*
+			 * Parallel LSD radix sort, ping-pong between [first, last) and [buffer, buffer + len).
+			 *
+			 * The range is split into `chunk_num` chunks. In each round, every chunk counts the histogram of itself,
+			 * the exclusive prefix sum taken bucket by bucket, chunk by chunk over all the histograms gives each chunk
+			 * disjoint destinations in every bucket, then all chunks are scattered at the same time.
+			 * As the chunks keep their order in each bucket, the sort is as stable as the serial one.
+			 *
+			 * @return true if the sorted sequence is located in the buffer, false if in [first, last)
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			bool parallel_lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+										Extract & extract, Order order,
+										kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width,
+										size_t chunk_num)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef typename radix_sort_extract_key_type<Extract, value_type>::type key_type;
+				typedef radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+				typedef typename traits::unsigned_key_type unsigned_key_type;
+				typedef typename traits::BUCKETS_NUM BUCKETS_NUM;
+				typedef typename traits::ROUNDS ROUNDS;
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const difference_type chunks(static_cast<difference_type>(chunk_num));
+
+				if (chunk_num < 2 || len <= static_cast<difference_type>(
+						parallel_radix_sort_serial_threshold<iterator>::value)) {
+					return detail::lsd_radix_sort(first, last, buffer, extract, order, radix_bit_width);
+				}
+
+				// cnt[(chunk * ROUNDS + round) * BUCKETS + bucket]
+				std::vector<size_t> cnt(chunk_num * ROUNDS::value * BUCKETS_NUM::value, 0);
+				size_t * const pcnt = &cnt[0];
+
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					iterator it(first + len * i / chunks);
+					const iterator chunk_last(first + len * (i + 1) / chunks);
+					size_t * const c = pcnt + i * ROUNDS::value * BUCKETS_NUM::value;
+					for (; it != chunk_last; ++it) {
+						unsigned_key_type key = detail::radix_sort_ordered_key<key_type>(extract(*it), order);
+						for (size_t round = 0; round < ROUNDS::value; ++round) {
+							++c[round * BUCKETS_NUM::value + traits::digit(key, round)];
+						}
+					}
+				}
+
+				bool in_buffer = false;
+				bool scattered = false;
+				const unsigned_key_type first_key = detail::radix_sort_ordered_key<key_type>(extract(*first), order);
+				for (size_t round = 0; round < ROUNDS::value; ++round) {
+					size_t first_bucket_num = 0;
+					for (size_t i = 0; i < chunk_num; ++i) {
+						first_bucket_num += pcnt[(i * ROUNDS::value + round) * BUCKETS_NUM::value + traits::digit(first_key, round)];
+					}
+					if (first_bucket_num == static_cast<size_t>(len)) {
+						continue;
+					}
+
+					/*
+					 * The histograms counted above are of the chunks of [first, last), they are valid until the first
+					 * scatter. Since then, the chunks of the source of the round need to be counted again.
+					 */
+					if (scattered) {
+#						pragma omp parallel for schedule(static)
+						for (difference_type i = 0; i < chunks; ++i) {
+							size_t * const c = pcnt + (i * ROUNDS::value + round) * BUCKETS_NUM::value;
+							for (size_t j = 0; j < BUCKETS_NUM::value; ++j) {
+								c[j] = 0;
+							}
+							if (in_buffer) {
+								detail::parallel_lsd_radix_sort_count(buffer + len * i / chunks, buffer + len * (i + 1) / chunks,
+																		c, round, extract, order, radix_bit_width);
+							} else {
+								detail::parallel_lsd_radix_sort_count(first + len * i / chunks, first + len * (i + 1) / chunks,
+																		c, round, extract, order, radix_bit_width);
+							}
+						}
+					}
+
+					{
+						size_t sum = 0;
+						for (size_t j = 0; j < BUCKETS_NUM::value; ++j) {
+							for (size_t i = 0; i < chunk_num; ++i) {
+								size_t & c = pcnt[(i * ROUNDS::value + round) * BUCKETS_NUM::value + j];
+								size_t t = c;
+								c = sum;
+								sum += t;
+							}
+						}
+					}
+
+#					pragma omp parallel for schedule(static)
+					for (difference_type i = 0; i < chunks; ++i) {
+						size_t * const c = pcnt + (i * ROUNDS::value + round) * BUCKETS_NUM::value;
+						if (in_buffer) {
+							detail::lsd_radix_sort_scatter(buffer + len * i / chunks, buffer + len * (i + 1) / chunks,
+															first, c, round, extract, order, radix_bit_width);
+						} else {
+							detail::lsd_radix_sort_scatter(first + len * i / chunks, first + len * (i + 1) / chunks,
+															buffer, c, round, extract, order, radix_bit_width);
+						}
+					}
+					in_buffer = !in_buffer;
+					scattered = true;
+				}
+				return in_buffer;
+			}
+
+		} // namespace detail
+
+		/*
+		 * Sort [first, last) by the keys extracted by `extract` with the openMP threads.
+		 * The result is the same as the one of radix_sort_by_key, as it is also stable.
+		 * `extract` is called by several threads at the same time.
+		 * The buffer should be able to hold n elements.
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort_by_key_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+													Extract extract, Order /*order*/,
+													kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+			typedef typename detail::radix_sort_extract_key_type<Extract, value_type>::type key_type;
+
+			KERBAL_STATIC_ASSERT(is_radix_sort_acceptable_type<key_type>::value,
+								"radix_sort only accepts integral type or IEEE 754 float/double key");
+
+			if (first == last) {
+				return;
+			}
+
+			const size_t chunk_num = detail::parallel_radix_sort_chunk_num();
+			if (detail::parallel_lsd_radix_sort(first, last, buffer, extract,
+												kerbal::type_traits::bool_constant<Order::value>(), radix_bit_width,
+												chunk_num)) {
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const difference_type chunks(static_cast<difference_type>(chunk_num));
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					kerbal::algorithm::copy(buffer + len * i / chunks, buffer + len * (i + 1) / chunks,
+											first + len * i / chunks);
+				}
+			}
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order>
+		void parallel_radix_sort_by_key_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+													Extract extract, Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_buffer(first, last, buffer, extract, order,
+																		kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract>
+		void parallel_radix_sort_by_key_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+													Extract extract)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_buffer(first, last, buffer, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+											Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_buffer(first, last, buffer,
+																		detail::radix_sort_identity_extract<value_type>(), order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Order>
+		void parallel_radix_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+											Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort_afford_buffer(first, last, buffer, order,
+																kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		void parallel_radix_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer)
+		{
+			kerbal::algorithm::parallel_radix_sort_afford_buffer(first, last, buffer, kerbal::type_traits::false_type());
+		}
+
+		/*
+		 * The buffer got from the allocator is copy constructed from [first, last), so value_type needn't be
+		 * default constructible.
+		 */
+		template <typename RandomAccessIterator, typename Allocator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort_by_key_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator,
+														Extract extract, Order order,
+														kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef kerbal::memory::allocator_traits<Allocator> allocator_traits;
+
+			const size_t buffer_length(static_cast<size_t>(kerbal::iterator::distance(first, last)));
+			if (buffer_length == 0) {
+				return;
+			}
+			value_type * const buffer = allocator_traits::allocate(allocator, buffer_length);
+			value_type * k = buffer;
+
+			struct dealloc_helper
+			{
+					Allocator & allocator;
+					size_t const & buffer_length;
+					value_type * const & buffer;
+					value_type * & k;
+
+					dealloc_helper(Allocator & allocator, size_t const & buffer_length, value_type * const & buffer, value_type * & k) KERBAL_NOEXCEPT :
+							allocator(allocator), buffer_length(buffer_length), buffer(buffer), k(k)
+					{
+					}
+
+					~dealloc_helper()
+					{
+						while (k != buffer) {
+							--k;
+							allocator_traits::destroy(this->allocator, k);
+						}
+						allocator_traits::deallocate(this->allocator, buffer, buffer_length);
+					}
+			} auto_dealloc_helper(allocator, buffer_length, buffer, k);
+
+			iterator it(first);
+			while (k != buffer + buffer_length) {
+				allocator_traits::construct(allocator, k, *it);
+				++k;
+				++it;
+			}
+
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_buffer(first, last, buffer, extract, order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename Allocator, typename Extract, typename Order>
+		void parallel_radix_sort_by_key_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator,
+														Extract extract, Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_allocator(first, last, allocator, extract, order,
+																			kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename Allocator, typename Extract>
+		void parallel_radix_sort_by_key_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator,
+														Extract extract)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_allocator(first, last, allocator, extract,
+																			kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename Allocator, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator,
+												Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_allocator(first, last, allocator,
+																			detail::radix_sort_identity_extract<value_type>(), order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename Allocator, typename Order>
+		void parallel_radix_sort_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator,
+												Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort_afford_allocator(first, last, allocator, order,
+																	kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename Allocator>
+		void parallel_radix_sort_afford_allocator(RandomAccessIterator first, RandomAccessIterator last, Allocator & allocator)
+		{
+			kerbal::algorithm::parallel_radix_sort_afford_allocator(first, last, allocator, kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract,
+										Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::parallel_radix_sort_by_key_afford_allocator(first, last, allocator, extract, order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename Extract, typename Order>
+		void parallel_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract, Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key(first, last, extract, order,
+														kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator, typename Extract>
+		void parallel_radix_sort_by_key(RandomAccessIterator first, RandomAccessIterator last, Extract extract)
+		{
+			kerbal::algorithm::parallel_radix_sort_by_key(first, last, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename RandomAccessIterator, typename Order, size_t RADIX_BIT_WIDTH>
+		void parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+								Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::parallel_radix_sort_afford_allocator(first, last, allocator, order, radix_bit_width);
+		}
+
+		template <typename RandomAccessIterator, typename Order>
+		void parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last, Order order)
+		{
+			kerbal::algorithm::parallel_radix_sort(first, last, order,
+													kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename RandomAccessIterator>
+		void parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			kerbal::algorithm::parallel_radix_sort(first, last, kerbal::type_traits::false_type());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARALLEL_RADIX_SORT_HPP
@@ -0,0 +1,210 @@
+/**
+ * @file       parallel_sort.hpp
+ * @brief
+ * @date       2020-08-23
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARALLEL_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARALLEL_SORT_HPP
+
+#include <kerbal/openmp/disable_warning.hpp>
+
+#include <kerbal/algorithm/sort/parallel_intro_sort.hpp>
+#include <kerbal/algorithm/sort/parallel_pigeonhole_sort.hpp>
+#include <kerbal/algorithm/sort/parallel_radix_sort.hpp>
+#include <kerbal/algorithm/sort/sort.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/openmp/execution_policy.hpp>
+#include <kerbal/type_traits/conditional.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <functional>
+
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename ForwardIterator, typename Compare>
+			struct parallel_sort_overload_policy_helper
+			{
+					typedef ForwardIterator iterator;
+					typedef sort_overload_policy_helper<iterator, Compare> serial_policy_helper;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_PIGEONHOLE_SORT_ASC::value
+					> IS_PARALLEL_PIGEONHOLE_SORT_ASC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_PIGEONHOLE_SORT_DESC::value
+					> IS_PARALLEL_PIGEONHOLE_SORT_DESC;
+
+					// the chunks of the other iterators can't be located in O(1), leave them to the serial sort
+					typedef kerbal::type_traits::bool_constant<
+							serial_policy_helper::IS_PIGEONHOLE_SORT_ASC::value ||
+							serial_policy_helper::IS_PIGEONHOLE_SORT_DESC::value
+					> IS_SERIAL_SORT;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_RADIX_SORT_ASC::value
+					> IS_PARALLEL_RADIX_SORT_ASC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_RADIX_SORT_DESC::value
+					> IS_PARALLEL_RADIX_SORT_DESC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_RADIX_SORT_BY_KEY_ASC::value
+					> IS_PARALLEL_RADIX_SORT_BY_KEY_ASC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value &&
+							serial_policy_helper::IS_RADIX_SORT_BY_KEY_DESC::value
+					> IS_PARALLEL_RADIX_SORT_BY_KEY_DESC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value
+					> IS_PARALLEL_INTRO_SORT;
+
+					typedef
+					typename kerbal::type_traits::conditional<
+							IS_PARALLEL_PIGEONHOLE_SORT_ASC::value,
+							kerbal::type_traits::integral_constant<size_t, 6>,
+							typename kerbal::type_traits::conditional<
+									IS_PARALLEL_PIGEONHOLE_SORT_DESC::value,
+									kerbal::type_traits::integral_constant<size_t, 7>,
+									typename kerbal::type_traits::conditional<
+											IS_SERIAL_SORT::value,
+											kerbal::type_traits::integral_constant<size_t, 1>,
+											typename kerbal::type_traits::conditional<
+													IS_PARALLEL_RADIX_SORT_ASC::value,
+													kerbal::type_traits::integral_constant<size_t, 2>,
+													typename kerbal::type_traits::conditional<
+															IS_PARALLEL_RADIX_SORT_DESC::value,
+															kerbal::type_traits::integral_constant<size_t, 3>,
+															typename kerbal::type_traits::conditional<
+																	IS_PARALLEL_RADIX_SORT_BY_KEY_ASC::value,
+																	kerbal::type_traits::integral_constant<size_t, 4>,
+																	typename kerbal::type_traits::conditional<
+																			IS_PARALLEL_RADIX_SORT_BY_KEY_DESC::value,
+																			kerbal::type_traits::integral_constant<size_t, 5>,
+																			typename kerbal::type_traits::conditional<
+																					IS_PARALLEL_INTRO_SORT::value,
+																					kerbal::type_traits::integral_constant<size_t, 0>,
+																					kerbal::type_traits::integral_constant<size_t, 1>
+																			>::type
+																	>::type
+															>::type
+													>::type
+											>::type
+									>::type
+							>::type
+					>::type
+					policy;
+
+			};
+
+			template <typename ForwardIterator, typename Compare>
+			struct parallel_sort_overload_policy:
+					parallel_sort_overload_policy_helper<ForwardIterator, Compare>::policy
+			{
+			};
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare compare,
+								kerbal::type_traits::integral_constant<size_t, 0>)
+			{
+				kerbal::algorithm::parallel_intro_sort(first, last, compare);
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare compare,
+								kerbal::type_traits::integral_constant<size_t, 1>)
+			{
+				kerbal::algorithm::sort(first, last, compare);
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare,
+								kerbal::type_traits::integral_constant<size_t, 2>)
+			{
+				kerbal::algorithm::parallel_radix_sort(first, last, kerbal::type_traits::false_type());
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare,
+								kerbal::type_traits::integral_constant<size_t, 3>)
+			{
+				kerbal::algorithm::parallel_radix_sort(first, last, kerbal::type_traits::true_type());
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare compare,
+								kerbal::type_traits::integral_constant<size_t, 4>)
+			{
+				typedef sort_compare_by_key_extract<typename Compare::key_type, typename Compare::extract_type> extract;
+				kerbal::algorithm::parallel_radix_sort_by_key(first, last, extract(compare.extract), kerbal::type_traits::false_type());
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare compare,
+								kerbal::type_traits::integral_constant<size_t, 5>)
+			{
+				typedef sort_compare_by_key_extract<typename Compare::key_type, typename Compare::extract_type> extract;
+				kerbal::algorithm::parallel_radix_sort_by_key(first, last, extract(compare.extract), kerbal::type_traits::true_type());
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare,
+								kerbal::type_traits::integral_constant<size_t, 6>)
+			{
+				kerbal::algorithm::parallel_pigeonhole_sort(first, last, kerbal::type_traits::false_type());
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_sort(ForwardIterator first, ForwardIterator last, Compare,
+								kerbal::type_traits::integral_constant<size_t, 7>)
+			{
+				kerbal::algorithm::parallel_pigeonhole_sort(first, last, kerbal::type_traits::true_type());
+			}
+
+		} // namespace detail
+
+		template <typename ForwardIterator, typename Compare>
+		void sort(kerbal::openmp::parallel_policy, ForwardIterator first, ForwardIterator last, Compare compare)
+		{
+			typedef ForwardIterator iterator;
+
+			kerbal::algorithm::detail::parallel_sort(first, last, compare,
+					kerbal::algorithm::detail::parallel_sort_overload_policy<iterator, Compare>());
+		}
+
+		template <typename ForwardIterator>
+		void sort(kerbal::openmp::parallel_policy policy, ForwardIterator first, ForwardIterator last)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::sort(policy, first, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARALLEL_SORT_HPP
@@ -0,0 +1,349 @@
+/**
+ * @file       parallel_stable_sort.hpp
+ * @brief
+ * @date       2020-08-29
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARALLEL_STABLE_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARALLEL_STABLE_SORT_HPP
+
+#include <kerbal/openmp/disable_warning.hpp>
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/openmp/execution_policy.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(_OPENMP)
+#	include <omp.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * ranges not longer than this threshold are sorted by the serial stable sort
+			 */
+			template <typename RandomAccessIterator>
+			struct parallel_stable_sort_serial_threshold:
+					kerbal::type_traits::integral_constant<size_t, 1 << 14>
+			{
+			};
+
+			inline
+			size_t parallel_stable_sort_chunk_num() KERBAL_NOEXCEPT
+			{
+#	if defined(_OPENMP)
+				return static_cast<size_t>(::omp_get_max_threads());
+#	else
+				return 1;
+#	endif
+			}
+
+			/*
+			 * Merge path co-ranking: the number of elements taken from [a, a + a_len) by the first k elements
+			 * output by the stable merge of [a, a + a_len) and [b, b + b_len), which takes from a on ties.
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type
+			parallel_merge_co_rank(typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type k,
+									RandomAccessIterator a, typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type a_len,
+									RandomAccessIterator b, typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type b_len,
+									Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				difference_type lo = k < b_len ? 0 : k - b_len;
+				difference_type hi = k < a_len ? k : a_len;
+				while (lo < hi) {
+					difference_type i = lo + (hi - lo) / 2;
+					difference_type j = k - i;
+					if (!cmp(b[j - 1], a[i])) { // a[i] <= b[j - 1], a[i] is output before b[j - 1]
+						lo = i + 1;
+					} else {
+						hi = i;
+					}
+				}
+				return lo;
+			}
+
+			/*
+			 * Output [out_first, out_last) of the merging level, in which the runs [bounds[2r], bounds[2r + 1]) and
+			 * [bounds[2r + 1], bounds[2r + 2]) of the source are merged to the same place of the destination.
+			 * The last run is copied if it has no partner.
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+			void parallel_stable_sort_merge_slice(RandomAccessIterator src, RandomAccessIterator2 dst,
+					const typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type * bounds,
+					size_t run_num,
+					typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type out_first,
+					typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type out_last,
+					Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				for (size_t r = 0; r < run_num; r += 2) {
+					difference_type lo = bounds[r];
+					difference_type mid = bounds[r + 1];
+					difference_type hi = r + 1 < run_num ? bounds[r + 2] : mid;
+					if (hi <= out_first) {
+						continue;
+					}
+					if (out_last <= lo) {
+						break;
+					}
+
+					difference_type k_first = (out_first < lo ? lo : out_first) - lo;
+					difference_type k_last = (hi < out_last ? hi : out_last) - lo;
+					iterator a(src + lo);
+					iterator b(src + mid);
+					difference_type a_len = mid - lo;
+					difference_type b_len = hi - mid;
+					difference_type i_first = detail::parallel_merge_co_rank(k_first, a, a_len, b, b_len, cmp);
+					difference_type i_last = detail::parallel_merge_co_rank(k_last, a, a_len, b, b_len, cmp);
+					kerbal::algorithm::merge(a + i_first, a + i_last,
+											b + (k_first - i_first), b + (k_last - i_last),
+											dst + (lo + k_first), cmp);
+				}
+			}
+
+			/*
+			 * @return true if the sorted sequence is located in the buffer, false if in [first, last)
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+			bool parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+										RandomAccessIterator2 buffer, Compare & cmp, size_t chunk_num)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const difference_type chunks(static_cast<difference_type>(chunk_num));
+
+				/*
+				 * Each chunk is sorted by the serial stable sort with its own part of the buffer.
+				 */
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					kerbal::algorithm::stable_sort_afford_buffer(first + len * i / chunks, first + len * (i + 1) / chunks,
+																buffer + len * i / chunks, cmp);
+				}
+
+				std::vector<difference_type> bounds(chunk_num + 1);
+				for (size_t i = 0; i <= chunk_num; ++i) {
+					bounds[i] = len * static_cast<difference_type>(i) / chunks;
+				}
+				const difference_type * const pbounds = &bounds[0];
+
+				/*
+				 * Each level merges the runs pairwise. The output of a level is split evenly by position
+				 * to the threads, each of them locates its part in the inputs by co-ranking, so that even the
+				 * last level, which is one single merge, keeps all the threads busy.
+				 */
+				bool in_buffer = false;
+				size_t run_num = chunk_num;
+				while (run_num > 1) {
+					if (in_buffer) {
+#						pragma omp parallel for schedule(static)
+						for (difference_type i = 0; i < chunks; ++i) {
+							detail::parallel_stable_sort_merge_slice(buffer, first, pbounds, run_num,
+																	len * i / chunks, len * (i + 1) / chunks, cmp);
+						}
+					} else {
+#						pragma omp parallel for schedule(static)
+						for (difference_type i = 0; i < chunks; ++i) {
+							detail::parallel_stable_sort_merge_slice(first, buffer, pbounds, run_num,
+																	len * i / chunks, len * (i + 1) / chunks, cmp);
+						}
+					}
+					in_buffer = !in_buffer;
+
+					size_t next_run_num = 0;
+					for (size_t r = 0; r < run_num; r += 2) {
+						bounds[next_run_num] = bounds[r];
+						++next_run_num;
+					}
+					bounds[next_run_num] = len;
+					run_num = next_run_num;
+				}
+				return in_buffer;
+			}
+
+		} // namespace detail
+
+		/*
+		 * Sort [first, last) by the openMP threads. The result is the same as the one of stable_sort.
+		 * The buffer should be able to hold n elements.
+		 */
+		template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+		void parallel_stable_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last,
+												RandomAccessIterator2 buffer, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			const difference_type len(kerbal::iterator::distance(first, last));
+			const size_t chunk_num = detail::parallel_stable_sort_chunk_num();
+			if (chunk_num < 2 || len <= static_cast<difference_type>(
+					detail::parallel_stable_sort_serial_threshold<iterator>::value)) {
+				kerbal::algorithm::stable_sort_afford_buffer(first, last, buffer, cmp);
+				return;
+			}
+
+			if (detail::parallel_stable_sort(first, last, buffer, cmp, chunk_num)) {
+				const difference_type chunks(static_cast<difference_type>(chunk_num));
+#				pragma omp parallel for schedule(static)
+				for (difference_type i = 0; i < chunks; ++i) {
+					kerbal::algorithm::copy(buffer + len * i / chunks, buffer + len * (i + 1) / chunks,
+											first + len * i / chunks);
+				}
+			}
+		}
+
+		template <typename RandomAccessIterator, typename RandomAccessIterator2>
+		void parallel_stable_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last,
+												RandomAccessIterator2 buffer)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::parallel_stable_sort_afford_buffer(first, last, buffer, std::less<value_type>());
+		}
+
+		/*
+		 * The buffer got from the allocator is copy constructed from [first, last), so value_type needn't be
+		 * default constructible.
+		 */
+		template <typename RandomAccessIterator, typename Allocator, typename Compare>
+		void parallel_stable_sort_afford_allocator(RandomAccessIterator first, RandomAccessIterator last,
+													Allocator & allocator, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef kerbal::memory::allocator_traits<Allocator> allocator_traits;
+
+			const difference_type buffer_length(kerbal::iterator::distance(first, last));
+			if (buffer_length == 0) {
+				return;
+			}
+			value_type * const buffer = allocator_traits::allocate(allocator, buffer_length);
+			value_type * k = buffer;
+
+			struct dealloc_helper
+			{
+				Allocator & allocator;
+				difference_type const & buffer_length;
+				value_type * const & buffer;
+				value_type * & k;
+
+				dealloc_helper(Allocator & allocator, difference_type const & buffer_length, value_type * const & buffer, value_type * & k) KERBAL_NOEXCEPT :
+						allocator(allocator), buffer_length(buffer_length), buffer(buffer), k(k)
+				{
+				}
+
+				~dealloc_helper()
+				{
+					while (k != buffer) {
+						--k;
+						allocator_traits::destroy(this->allocator, k);
+					}
+					allocator_traits::deallocate(this->allocator, buffer, buffer_length);
+				}
+			} auto_dealloc_helper(allocator, buffer_length, buffer, k);
+
+			iterator it(first);
+			while (k != buffer + buffer_length) {
+				allocator_traits::construct(allocator, k, *it);
+				++k;
+				++it;
+			}
+
+			kerbal::algorithm::parallel_stable_sort_afford_buffer(first, last, buffer, cmp);
+		}
+
+		template <typename RandomAccessIterator, typename Allocator>
+		void parallel_stable_sort_afford_allocator(RandomAccessIterator first, RandomAccessIterator last,
+													Allocator & allocator)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::parallel_stable_sort_afford_allocator(first, last, allocator, std::less<value_type>());
+		}
+
+		template <typename RandomAccessIterator, typename Compare>
+		void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::parallel_stable_sort_afford_allocator(first, last, allocator, cmp);
+		}
+
+		template <typename RandomAccessIterator>
+		void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::parallel_stable_sort(first, last, std::less<value_type>());
+		}
+
+		namespace detail
+		{
+
+			template <typename ForwardIterator, typename Compare>
+			void parallel_stable_sort(ForwardIterator first, ForwardIterator last, Compare cmp,
+										std::forward_iterator_tag)
+			{
+				kerbal::algorithm::stable_sort(first, last, cmp);
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			void parallel_stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+										std::random_access_iterator_tag)
+			{
+				kerbal::algorithm::parallel_stable_sort(first, last, cmp);
+			}
+
+		} // namespace detail
+
+		template <typename ForwardIterator, typename Compare>
+		void stable_sort(kerbal::openmp::parallel_policy, ForwardIterator first, ForwardIterator last, Compare cmp)
+		{
+			kerbal::algorithm::detail::parallel_stable_sort(first, last, cmp, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator>
+		void stable_sort(kerbal::openmp::parallel_policy policy, ForwardIterator first, ForwardIterator last)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::stable_sort(policy, first, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARALLEL_STABLE_SORT_HPP
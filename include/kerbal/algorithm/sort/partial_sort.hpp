@@ -0,0 +1,119 @@
+/**
+ * @file       partial_sort.hpp
+ * @brief
+ * @date       2020-08-31
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
+
+#include <kerbal/algorithm/heap.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		/**
+		 * @brief Place the smallest middle - first elements of [first, last) in [first, middle) in sorted order,
+		 *        the rest are left in [middle, last) in unspecified order.
+		 *
+		 * O(n log(middle - first)) comparisons. Not stable.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void partial_sort(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+						Compare cmp)
+		{
+			typedef BidirectionalIterator iterator;
+
+			if (first == middle) {
+				return;
+			}
+
+			// max heap of the smallest elements up to now
+			kerbal::algorithm::make_heap(first, middle, cmp);
+			for (iterator it(middle); it != last; ++it) {
+				if (cmp(*it, *first)) {
+					kerbal::algorithm::iter_swap(it, first);
+					kerbal::algorithm::detail::adjust_top_down_unguarded(first, middle, cmp);
+				}
+			}
+			kerbal::algorithm::sort_heap(first, middle, cmp);
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void partial_sort(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::partial_sort(first, middle, last, std::less<value_type>());
+		}
+
+		/**
+		 * @brief Copy the smallest min(last - first, d_last - d_first) elements of [first, last) to
+		 *        [d_first, d_first + min(last - first, d_last - d_first)) in sorted order.
+		 *
+		 * @return d_first + min(last - first, d_last - d_first)
+		 */
+		template <typename InputIterator, typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		BidirectionalIterator
+		partial_sort_copy(InputIterator first, InputIterator last,
+						BidirectionalIterator d_first, BidirectionalIterator d_last, Compare cmp)
+		{
+			typedef BidirectionalIterator iterator;
+
+			iterator d_middle(d_first);
+			while (first != last && d_middle != d_last) {
+				*d_middle = *first;
+				++d_middle;
+				++first;
+			}
+			if (d_first == d_middle) {
+				return d_middle;
+			}
+
+			kerbal::algorithm::make_heap(d_first, d_middle, cmp);
+			while (first != last) {
+				if (cmp(*first, *d_first)) {
+					*d_first = *first;
+					kerbal::algorithm::detail::adjust_top_down_unguarded(d_first, d_middle, cmp);
+				}
+				++first;
+			}
+			kerbal::algorithm::sort_heap(d_first, d_middle, cmp);
+			return d_middle;
+		}
+
+		template <typename InputIterator, typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		BidirectionalIterator
+		partial_sort_copy(InputIterator first, InputIterator last,
+						BidirectionalIterator d_first, BidirectionalIterator d_last)
+		{
+			typedef InputIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			return kerbal::algorithm::partial_sort_copy(first, last, d_first, d_last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
@@ -14,6 +14,7 @@
 
 #include <kerbal/algorithm/swap.hpp>
 #include <kerbal/algorithm/sort/detail/quick_sort_pivot.hpp>
+#include <kerbal/algorithm/sort/detail/sorting_network.hpp>
 #include <kerbal/algorithm/sort/insertion_sort.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
@@ -56,7 +57,7 @@ namespace kerbal
 				last = partition_point;
 			}
 			// dist <= 16
-			kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+			detail::small_sort(first, last, cmp);
 		}
 
 		template <typename BidirectionalIterator>
@@ -96,7 +97,7 @@ namespace kerbal
 					}
 				}
 
-				kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+				detail::small_sort(first, last, cmp);
 			}
 		}
 
@@ -13,12 +13,25 @@
 #define KERBAL_ALGORITHM_SORT_RADIX_SORT_HPP
 
 #include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/compatibility/static_assert.hpp>
 #include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/decay.hpp>
 #include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 #include <kerbal/type_traits/sign_deduction.hpp>
+#include <kerbal/utility/declval.hpp>
 
 #include <climits>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <vector>
 
 namespace kerbal
@@ -27,141 +40,523 @@ namespace kerbal
 	namespace algorithm
 	{
 
+		template <typename ValueType>
+		struct is_radix_sort_acceptable_type:
+				kerbal::type_traits::bool_constant<
+						kerbal::type_traits::is_integral<ValueType>::value ||
+						(
+							kerbal::type_traits::is_floating_point<ValueType>::value &&
+							std::numeric_limits<typename kerbal::type_traits::remove_cv<ValueType>::type>::is_iec559 &&
+							(sizeof(ValueType) == 4 || sizeof(ValueType) == 8)
+						)
+				>
+		{
+		};
+
 		namespace detail
 		{
 
-			template <typename ForwardIterator>
-			void __radix_sort_back_fill(ForwardIterator first,
-					kerbal::type_traits::false_type /*asc*/,
-					kerbal::type_traits::false_type /*unsigned*/,
-					const std::vector<typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type> buckets[],
-					size_t BUCKETS_NUM)
+			template <typename Tp>
+			struct radix_sort_unsigned_key_type:
+					kerbal::compatibility::__fixed_width_unsigned_interger_helper<sizeof(Tp) * CHAR_BIT>
 			{
-				for (size_t i = 0; i < BUCKETS_NUM; ++i) {
-					first = kerbal::algorithm::copy(buckets[i].begin(), buckets[i].end(), first);
-				}
+			};
+
+			/*
+			 * 0: unsigned integer, 1: signed integer, 2: floating point
+			 */
+			template <typename Tp, bool = kerbal::type_traits::is_floating_point<Tp>::value>
+			struct radix_sort_key_category:
+					kerbal::type_traits::integral_constant<int, 2>
+			{
+			};
+
+			template <typename Tp>
+			struct radix_sort_key_category<Tp, false>:
+					kerbal::type_traits::integral_constant<int, kerbal::type_traits::is_signed<Tp>::value ? 1 : 0>
+			{
+			};
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR
+			typename radix_sort_unsigned_key_type<Tp>::type
+			radix_sort_unsigned_key(const Tp & value, kerbal::type_traits::integral_constant<int, 0> /*unsigned*/) KERBAL_NOEXCEPT
+			{
+				typedef typename radix_sort_unsigned_key_type<Tp>::type unsigned_key_type;
+				return static_cast<unsigned_key_type>(value);
 			}
 
-			template <typename ForwardIterator>
-			void __radix_sort_back_fill(ForwardIterator first,
-					kerbal::type_traits::true_type /*desc*/,
-					kerbal::type_traits::false_type /*unsigned*/,
-					const std::vector<typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type> buckets[],
-					size_t BUCKETS_NUM)
-			{
-				size_t i = BUCKETS_NUM;
-				while (i > 0) {
-					--i;
-					first = kerbal::algorithm::reverse_copy(buckets[i].begin(), buckets[i].end(), first);
-				}
+			/*
+			 * flip the sign bit, so that the negative ones are placed before the non-negative ones
+			 */
+			template <typename Tp>
+			KERBAL_CONSTEXPR
+			typename radix_sort_unsigned_key_type<Tp>::type
+			radix_sort_unsigned_key(const Tp & value, kerbal::type_traits::integral_constant<int, 1> /*signed*/) KERBAL_NOEXCEPT
+			{
+				typedef typename radix_sort_unsigned_key_type<Tp>::type unsigned_key_type;
+				return static_cast<unsigned_key_type>(
+						static_cast<unsigned_key_type>(value) ^
+						(static_cast<unsigned_key_type>(1) << (sizeof(unsigned_key_type) * CHAR_BIT - 1))
+				);
 			}
 
-			template <typename ForwardIterator>
-			void __radix_sort_back_fill(ForwardIterator first,
-					kerbal::type_traits::false_type /*asc*/,
-					kerbal::type_traits::true_type /*signed*/,
-					const std::vector<typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type> buckets[],
-					size_t BUCKETS_NUM)
+			/*
+			 * IEEE 754: flip all the bits of the negative ones and only the sign bit of the non-negative ones
+			 */
+			template <typename Tp>
+			typename radix_sort_unsigned_key_type<Tp>::type
+			radix_sort_unsigned_key(const Tp & value, kerbal::type_traits::integral_constant<int, 2> /*floating point*/) KERBAL_NOEXCEPT
 			{
-				for (size_t i = BUCKETS_NUM / 2; i < BUCKETS_NUM; ++i) {
-					first = kerbal::algorithm::copy(buckets[i].begin(), buckets[i].end(), first);
-				}
-				for (size_t i = 0; i < BUCKETS_NUM / 2; ++i) {
-					first = kerbal::algorithm::copy(buckets[i].begin(), buckets[i].end(), first);
+				typedef typename radix_sort_unsigned_key_type<Tp>::type unsigned_key_type;
+				typedef kerbal::type_traits::integral_constant<unsigned_key_type,
+						static_cast<unsigned_key_type>(1) << (sizeof(unsigned_key_type) * CHAR_BIT - 1)> SIGN_BIT;
+
+				unsigned_key_type bits;
+				std::memcpy(&bits, &value, sizeof(unsigned_key_type));
+				return static_cast<unsigned_key_type>(
+						(bits & SIGN_BIT::value) ?
+						~bits :
+						bits | SIGN_BIT::value
+				);
+			}
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR
+			typename radix_sort_unsigned_key_type<Tp>::type
+			radix_sort_ordered_key(const Tp & value, kerbal::type_traits::false_type /*asc*/) KERBAL_NOEXCEPT
+			{
+				return radix_sort_unsigned_key(value, radix_sort_key_category<Tp>());
+			}
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR
+			typename radix_sort_unsigned_key_type<Tp>::type
+			radix_sort_ordered_key(const Tp & value, kerbal::type_traits::true_type /*desc*/) KERBAL_NOEXCEPT
+			{
+				typedef typename radix_sort_unsigned_key_type<Tp>::type unsigned_key_type;
+				return static_cast<unsigned_key_type>(~radix_sort_unsigned_key(value, radix_sort_key_category<Tp>()));
+			}
+
+			template <typename Tp>
+			struct radix_sort_identity_extract
+			{
+					typedef Tp result_type;
+
+					KERBAL_CONSTEXPR
+					const Tp & operator()(const Tp & value) const KERBAL_NOEXCEPT
+					{
+						return value;
+					}
+			};
+
+#	if __cplusplus >= 201103L
+
+			template <typename Extract, typename Tp>
+			struct radix_sort_extract_key_type
+			{
+					typedef typename kerbal::type_traits::decay<
+							decltype(kerbal::utility::declval<Extract&>()(kerbal::utility::declval<const Tp&>()))
+					>::type type;
+			};
+
+#	else
+
+			template <typename Extract, typename Tp>
+			struct radix_sort_extract_key_type
+			{
+					typedef typename kerbal::type_traits::decay<typename Extract::result_type>::type type;
+			};
+
+			template <typename Ret, typename Arg, typename Tp>
+			struct radix_sort_extract_key_type<Ret(*)(Arg), Tp>
+			{
+					typedef typename kerbal::type_traits::decay<Ret>::type type;
+			};
+
+#	endif
+
+			template <typename Key, size_t RADIX_BIT_WIDTH>
+			struct radix_sort_traits
+			{
+					typedef typename radix_sort_unsigned_key_type<Key>::type unsigned_key_type;
+					typedef kerbal::type_traits::integral_constant<size_t, static_cast<size_t>(1) << RADIX_BIT_WIDTH> BUCKETS_NUM;
+					typedef kerbal::type_traits::integral_constant<size_t, sizeof(unsigned_key_type) * CHAR_BIT> KEY_BIT_WIDTH;
+					typedef kerbal::type_traits::integral_constant<size_t,
+							KEY_BIT_WIDTH::value / RADIX_BIT_WIDTH + (KEY_BIT_WIDTH::value % RADIX_BIT_WIDTH != 0)> ROUNDS;
+
+					KERBAL_CONSTEXPR
+					static size_t digit(unsigned_key_type key, size_t round) KERBAL_NOEXCEPT
+					{
+						return static_cast<size_t>(key >> (RADIX_BIT_WIDTH * round)) & (BUCKETS_NUM::value - 1);
+					}
+			};
+
+			/*
+			 * Zero initialized counters of the radix sorts. They are kept on the stack while not larger than
+			 * 16 KiB (the histograms of all the rounds of 64 bit keys with the default 8 bit radix), and put on
+			 * the heap beyond that, so that the wide radices don't overflow the stacks of the threads.
+			 */
+			template <typename Tp, size_t N, bool = (N * sizeof(Tp) <= 16384)>
+			class radix_sort_counter
+			{
+				private:
+					Tp k_data[N];
+
+				public:
+					radix_sort_counter() KERBAL_NOEXCEPT
+					{
+						for (size_t i = 0; i < N; ++i) {
+							this->k_data[i] = 0;
+						}
+					}
+
+					Tp * data() KERBAL_NOEXCEPT
+					{
+						return this->k_data;
+					}
+			};
+
+			template <typename Tp, size_t N>
+			class radix_sort_counter<Tp, N, false>
+			{
+				private:
+					std::vector<Tp> k_data;
+
+				public:
+					radix_sort_counter() :
+							k_data(N, 0)
+					{
+					}
+
+					Tp * data() KERBAL_NOEXCEPT
+					{
+						return &this->k_data[0];
+					}
+			};
+
+			/*
+			 * move [first, last) to `to`, bucket by bucket of the digit of the round.
+			 * cnt[i] is the beginning offset of bucket i, and be increased after each element is placed.
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			void lsd_radix_sort_scatter(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 to,
+										size_t cnt[], size_t round, Extract & extract, Order order,
+										kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH>)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename radix_sort_extract_key_type<Extract, value_type>::type key_type;
+				typedef radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+
+				while (first != last) {
+					size_t bucket_id = traits::digit(detail::radix_sort_ordered_key<key_type>(extract(*first), order), round);
+					*kerbal::iterator::next(to, cnt[bucket_id]) = kerbal::compatibility::to_xvalue(*first);
+					++cnt[bucket_id];
+					++first;
 				}
 			}
 
-			template <typename ForwardIterator>
-			void __radix_sort_back_fill(ForwardIterator first,
-					kerbal::type_traits::true_type /*desc*/,
-					kerbal::type_traits::true_type /*signed*/,
-					const std::vector<typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type> buckets[],
-					size_t BUCKETS_NUM)
-			{
-				{
-					size_t i = BUCKETS_NUM / 2;
-					while (i > 0) {
-						--i;
-						first = kerbal::algorithm::reverse_copy(buckets[i].begin(), buckets[i].end(), first);
+			/*
+			 * LSD radix sort, ping-pong between [first, last) and [buffer, buffer + len)
+			 *
+			 * The histograms of all rounds are counted by one pass, and the rounds in which all elements
+			 * share the same digit are skipped.
+			 *
+			 * @return true if the sorted sequence is located in the buffer, false if in [first, last)
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			bool lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+								Extract & extract, Order order,
+								kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+				typedef typename radix_sort_extract_key_type<Extract, value_type>::type key_type;
+				typedef radix_sort_traits<key_type, RADIX_BIT_WIDTH> traits;
+				typedef typename traits::unsigned_key_type unsigned_key_type;
+				typedef typename traits::BUCKETS_NUM BUCKETS_NUM;
+				typedef typename traits::ROUNDS ROUNDS;
+
+				if (first == last) {
+					return false;
+				}
+
+				const difference_type len(kerbal::iterator::distance(first, last));
+				const RandomAccessIterator2 buffer_last(kerbal::iterator::next(buffer, len));
+
+				// cnt[round * BUCKETS + bucket]
+				radix_sort_counter<size_t, ROUNDS::value * BUCKETS_NUM::value> counter;
+				size_t * const cnt = counter.data();
+				for (iterator it(first); it != last; ++it) {
+					unsigned_key_type key = detail::radix_sort_ordered_key<key_type>(extract(*it), order);
+					for (size_t round = 0; round < ROUNDS::value; ++round) {
+						++cnt[round * BUCKETS_NUM::value + traits::digit(key, round)];
 					}
 				}
-				{
-					size_t i = BUCKETS_NUM;
-					while (i > BUCKETS_NUM / 2) {
-						--i;
-						first = kerbal::algorithm::reverse_copy(buckets[i].begin(), buckets[i].end(), first);
+
+				bool in_buffer = false;
+				const unsigned_key_type first_key = detail::radix_sort_ordered_key<key_type>(extract(*first), order);
+				for (size_t round = 0; round < ROUNDS::value; ++round) {
+					size_t * const c = cnt + round * BUCKETS_NUM::value;
+					if (c[traits::digit(first_key, round)] == static_cast<size_t>(len)) {
+						continue;
+					}
+
+					size_t sum = 0;
+					for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
+						size_t t = c[i];
+						c[i] = sum;
+						sum += t;
 					}
+
+					if (in_buffer) {
+						detail::lsd_radix_sort_scatter(buffer, buffer_last, first, c, round, extract, order, radix_bit_width);
+					} else {
+						detail::lsd_radix_sort_scatter(first, last, buffer, c, round, extract, order, radix_bit_width);
+					}
+					in_buffer = !in_buffer;
+				}
+				return in_buffer;
+			}
+
+			template <typename ForwardIterator, typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			void radix_sort_by_key_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer,
+										Extract & extract, Order order,
+										kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width,
+										std::forward_iterator_tag)
+			{
+				RandomAccessIterator buffer_mid(kerbal::algorithm::copy(first, last, buffer));
+				if (detail::lsd_radix_sort(buffer, buffer_mid, buffer_mid, extract, order, radix_bit_width)) {
+					kerbal::algorithm::copy(buffer_mid, kerbal::iterator::next(buffer_mid, kerbal::iterator::distance(buffer, buffer_mid)), first);
+				} else {
+					kerbal::algorithm::copy(buffer, buffer_mid, first);
+				}
+			}
+
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+			void radix_sort_by_key_afford_buffer(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator2 buffer,
+										Extract & extract, Order order,
+										kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width,
+										std::random_access_iterator_tag)
+			{
+				if (detail::lsd_radix_sort(first, last, buffer, extract, order, radix_bit_width)) {
+					kerbal::algorithm::copy(buffer, kerbal::iterator::next(buffer, kerbal::iterator::distance(first, last)), first);
 				}
 			}
 
+			inline KERBAL_CONSTEXPR
+			size_t radix_sort_buffer_length(size_t len, std::forward_iterator_tag) KERBAL_NOEXCEPT
+			{
+				return 2 * len;
+			}
+
+			inline KERBAL_CONSTEXPR
+			size_t radix_sort_buffer_length(size_t len, std::random_access_iterator_tag) KERBAL_NOEXCEPT
+			{
+				return len;
+			}
+
 		} // namespace detail
 
-		template <typename ValueType>
-		struct is_radix_sort_acceptable_type:
-				kerbal::type_traits::is_integral<ValueType>
+		/*
+		 * Sort [first, last) by the keys extracted by `extract`, which should be integers or IEEE 754 float/double.
+		 * The sort is stable.
+		 * The buffer should be able to hold n elements if ForwardIterator is a random access iterator, 2n otherwise.
+		 */
+		template <typename ForwardIterator, typename RandomAccessIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort_by_key_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer,
+									Extract extract, Order /*order*/,
+									kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
 		{
-		};
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef typename detail::radix_sort_extract_key_type<Extract, value_type>::type key_type;
 
-		template <typename ForwardIterator, typename Order, size_t RADIX_BIT_WIDTH>
-		void radix_sort(ForwardIterator first, ForwardIterator last,
-						Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> /*radix_bit_width*/)
+			KERBAL_STATIC_ASSERT(is_radix_sort_acceptable_type<key_type>::value,
+								"radix_sort only accepts integral type or IEEE 754 float/double key");
+
+			kerbal::algorithm::detail::radix_sort_by_key_afford_buffer(first, last, buffer, extract,
+															kerbal::type_traits::bool_constant<Order::value>(), radix_bit_width,
+															kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator, typename RandomAccessIterator, typename Extract, typename Order>
+		void radix_sort_by_key_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer,
+											Extract extract, Order order)
+		{
+			kerbal::algorithm::radix_sort_by_key_afford_buffer(first, last, buffer, extract, order,
+																kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename ForwardIterator, typename RandomAccessIterator, typename Extract>
+		void radix_sort_by_key_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer,
+											Extract extract)
+		{
+			kerbal::algorithm::radix_sort_by_key_afford_buffer(first, last, buffer, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename ForwardIterator, typename RandomAccessIterator, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer,
+									Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
 		{
 			typedef ForwardIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
 
-			KERBAL_STATIC_ASSERT(is_radix_sort_acceptable_type<value_type>::value, "radix_sort only accepts integral type");
+			kerbal::algorithm::radix_sort_by_key_afford_buffer(first, last, buffer,
+																detail::radix_sort_identity_extract<value_type>(), order, radix_bit_width);
+		}
 
-			typedef kerbal::type_traits::integral_constant<size_t, 1 << RADIX_BIT_WIDTH> BUCKETS_NUM;
-			std::vector<value_type> buckets[2][BUCKETS_NUM::value];
+		template <typename ForwardIterator, typename RandomAccessIterator, typename Order>
+		void radix_sort_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer, Order order)
+		{
+			kerbal::algorithm::radix_sort_afford_buffer(first, last, buffer, order,
+														kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
 
-			typedef kerbal::type_traits::integral_constant<size_t, sizeof(value_type) * CHAR_BIT> VALUE_TYPE_BIT_WIDTH;
-			typedef kerbal::type_traits::integral_constant<size_t, VALUE_TYPE_BIT_WIDTH::value / RADIX_BIT_WIDTH + (VALUE_TYPE_BIT_WIDTH::value % RADIX_BIT_WIDTH != 0)> ROUNDS;
+		template <typename ForwardIterator, typename RandomAccessIterator>
+		void radix_sort_afford_buffer(ForwardIterator first, ForwardIterator last, RandomAccessIterator buffer)
+		{
+			kerbal::algorithm::radix_sort_afford_buffer(first, last, buffer, kerbal::type_traits::false_type());
+		}
 
-//			size_t dist = kerbal::iterator::distance(first, last) /*/ BUCKETS_NUM::value*/;
-//			for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
-//				buckets[0][i].reserve(dist);
-//				buckets[1][i].reserve(dist);
-//			}
+		template <typename ForwardIterator, typename Allocator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort_by_key_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator,
+										Extract extract, Order order,
+										kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef kerbal::memory::allocator_traits<Allocator> allocator_traits;
 
-			for (iterator it(first); it != last; ++it) {
-				int bucket_id = *it % BUCKETS_NUM::value;
-				buckets[0][bucket_id].push_back(*it);
+			size_t buffer_length(detail::radix_sort_buffer_length(
+					static_cast<size_t>(kerbal::iterator::distance(first, last)), kerbal::iterator::iterator_category(first)));
+			if (buffer_length == 0) {
+				return;
 			}
+			value_type * const buffer = allocator_traits::allocate(allocator, buffer_length);
+			value_type * k = buffer;
 
-			for (size_t round = 1; round < ROUNDS::value; ++round) {
-				std::vector<value_type> (& buckets_from)[BUCKETS_NUM::value] = buckets[(round + 1) % 2];
-				std::vector<value_type> (& buckets_to)[BUCKETS_NUM::value] = buckets[round % 2];
+			struct dealloc_helper
+			{
+					Allocator & allocator;
+					size_t const & buffer_length;
+					value_type * const & buffer;
+					value_type * & k;
 
-				for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
-					buckets_to[i].clear();
-				}
-				for (size_t i = 0; i < BUCKETS_NUM::value; ++i) {
-					typename std::vector<value_type>::iterator it(buckets_from[i].begin());
-					typename std::vector<value_type>::iterator end(buckets_from[i].end());
-					while (it != end) {
-						int bucket_id = (*it >> (RADIX_BIT_WIDTH * round)) % BUCKETS_NUM::value;
-						buckets_to[bucket_id].push_back(*it);
-						++it;
+					dealloc_helper(Allocator & allocator, size_t const & buffer_length, value_type * const & buffer, value_type * & k) KERBAL_NOEXCEPT :
+							allocator(allocator), buffer_length(buffer_length), buffer(buffer), k(k)
+					{
+					}
+
+					~dealloc_helper()
+					{
+						while (k != buffer) {
+							--k;
+							allocator_traits::destroy(this->allocator, k);
+						}
+						allocator_traits::deallocate(this->allocator, buffer, buffer_length);
 					}
+			} auto_dealloc_helper(allocator, buffer_length, buffer, k);
+
+			// copy constructed from the input (repeated if the buffer is longer), so value_type needn't be default constructible
+			iterator it(first);
+			while (k != buffer + buffer_length) {
+				allocator_traits::construct(allocator, k, *it);
+				++k;
+				++it;
+				if (it == last) {
+					it = first;
 				}
 			}
 
-			kerbal::algorithm::detail::__radix_sort_back_fill(first, order,
-															kerbal::type_traits::is_signed<value_type>(),
-															buckets[(ROUNDS::value + 1) % 2], BUCKETS_NUM::value);
+			kerbal::algorithm::radix_sort_by_key_afford_buffer(first, last, buffer, extract, order, radix_bit_width);
+		}
+
+		template <typename ForwardIterator, typename Allocator, typename Extract, typename Order>
+		void radix_sort_by_key_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator,
+												Extract extract, Order order)
+		{
+			kerbal::algorithm::radix_sort_by_key_afford_allocator(first, last, allocator, extract, order,
+																	kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename ForwardIterator, typename Allocator, typename Extract>
+		void radix_sort_by_key_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator,
+												Extract extract)
+		{
+			kerbal::algorithm::radix_sort_by_key_afford_allocator(first, last, allocator, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename ForwardIterator, typename Allocator, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator,
+										Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+
+			kerbal::algorithm::radix_sort_by_key_afford_allocator(first, last, allocator,
+																	detail::radix_sort_identity_extract<value_type>(), order, radix_bit_width);
+		}
+
+		template <typename ForwardIterator, typename Allocator, typename Order>
+		void radix_sort_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator, Order order)
+		{
+			kerbal::algorithm::radix_sort_afford_allocator(first, last, allocator, order,
+															kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename ForwardIterator, typename Allocator>
+		void radix_sort_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator)
+		{
+			kerbal::algorithm::radix_sort_afford_allocator(first, last, allocator, kerbal::type_traits::false_type());
+		}
+
+		template <typename ForwardIterator, typename Extract, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort_by_key(ForwardIterator first, ForwardIterator last, Extract extract,
+						Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::radix_sort_by_key_afford_allocator(first, last, allocator, extract, order, radix_bit_width);
+		}
+
+		template <typename ForwardIterator, typename Extract, typename Order>
+		void radix_sort_by_key(ForwardIterator first, ForwardIterator last, Extract extract, Order order)
+		{
+			kerbal::algorithm::radix_sort_by_key(first, last, extract, order,
+												kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
+		}
+
+		template <typename ForwardIterator, typename Extract>
+		void radix_sort_by_key(ForwardIterator first, ForwardIterator last, Extract extract)
+		{
+			kerbal::algorithm::radix_sort_by_key(first, last, extract, kerbal::type_traits::false_type());
+		}
+
+		template <typename ForwardIterator, typename Order, size_t RADIX_BIT_WIDTH>
+		void radix_sort(ForwardIterator first, ForwardIterator last,
+						Order order, kerbal::type_traits::integral_constant<size_t, RADIX_BIT_WIDTH> radix_bit_width)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::radix_sort_afford_allocator(first, last, allocator, order, radix_bit_width);
 		}
 
 		template <typename ForwardIterator, typename Order>
-		void radix_sort(ForwardIterator first, ForwardIterator last, Order /*order*/)
+		void radix_sort(ForwardIterator first, ForwardIterator last, Order order)
 		{
-			kerbal::algorithm::radix_sort(first, last, kerbal::type_traits::bool_constant<Order::value>(),
+			kerbal::algorithm::radix_sort(first, last, order,
 											kerbal::type_traits::integral_constant<size_t, CHAR_BIT>());
 		}
 
 		template <typename ForwardIterator>
 		void radix_sort(ForwardIterator first, ForwardIterator last)
 		{
-			kerbal::algorithm::radix_sort(first, last, type_traits::false_type());
+			kerbal::algorithm::radix_sort(first, last, kerbal::type_traits::false_type());
 		}
 
 	} // namespace algorithm
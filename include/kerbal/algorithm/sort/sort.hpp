@@ -12,13 +12,17 @@
 #ifndef KERBAL_ALGORITHM_SORT_SORT_HPP
 #define KERBAL_ALGORITHM_SORT_SORT_HPP
 
+#include <kerbal/algorithm/sort/compare_by_key.hpp>
 #include <kerbal/algorithm/sort/detail/actual_bit_width.hpp>
 #include <kerbal/algorithm/sort/intro_sort.hpp>
 #include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
 #include <kerbal/algorithm/sort/radix_sort.hpp>
 #include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
 #include <kerbal/type_traits/conditional.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
 #include <kerbal/type_traits/integral_constant.hpp>
 #include <kerbal/type_traits/is_same.hpp>
 
@@ -34,6 +38,62 @@ namespace kerbal
 		namespace detail
 		{
 
+			template <typename Compare>
+			struct sort_is_radix_sort_by_key_asc: kerbal::type_traits::false_type
+			{
+			};
+
+			template <typename Key, typename Extract>
+			struct sort_is_radix_sort_by_key_asc<kerbal::algorithm::compare_by_key<Key, Extract, std::less<Key> > >:
+					kerbal::algorithm::is_radix_sort_acceptable_type<Key>
+			{
+			};
+
+			template <typename Key, typename Extract>
+			struct sort_is_radix_sort_by_key_asc<kerbal::algorithm::compare_by_key<Key, Extract, std::less_equal<Key> > >:
+					kerbal::algorithm::is_radix_sort_acceptable_type<Key>
+			{
+			};
+
+			template <typename Compare>
+			struct sort_is_radix_sort_by_key_desc: kerbal::type_traits::false_type
+			{
+			};
+
+			template <typename Key, typename Extract>
+			struct sort_is_radix_sort_by_key_desc<kerbal::algorithm::compare_by_key<Key, Extract, std::greater<Key> > >:
+					kerbal::algorithm::is_radix_sort_acceptable_type<Key>
+			{
+			};
+
+			template <typename Key, typename Extract>
+			struct sort_is_radix_sort_by_key_desc<kerbal::algorithm::compare_by_key<Key, Extract, std::greater_equal<Key> > >:
+					kerbal::algorithm::is_radix_sort_acceptable_type<Key>
+			{
+			};
+
+			/*
+			 * cast the extracted key to Key, so that radix sort orders the same keys as the KeyCompare does
+			 */
+			template <typename Key, typename Extract>
+			struct sort_compare_by_key_extract
+			{
+					typedef Key result_type;
+
+					Extract extract;
+
+					explicit sort_compare_by_key_extract(const Extract & extract) :
+							extract(extract)
+					{
+					}
+
+					template <typename Entity>
+					Key operator()(const Entity & entity) const
+					{
+						return static_cast<Key>(extract(entity));
+					}
+			};
+
 			template <typename ForwardIterator, typename Compare>
 			struct sort_overload_policy_helper
 			{
@@ -76,6 +136,16 @@ namespace kerbal
 							)
 					> IS_RADIX_SORT_DESC;
 
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_forward_compatible_iterator<iterator>::value &&
+							sort_is_radix_sort_by_key_asc<Compare>::value
+					> IS_RADIX_SORT_BY_KEY_ASC;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_forward_compatible_iterator<iterator>::value &&
+							sort_is_radix_sort_by_key_desc<Compare>::value
+					> IS_RADIX_SORT_BY_KEY_DESC;
+
 					typedef kerbal::type_traits::bool_constant<
 							kerbal::iterator::is_random_access_compatible_iterator<iterator>::value
 					> IS_INTRO_SORT_DESC;
@@ -94,9 +164,17 @@ namespace kerbal
 													IS_RADIX_SORT_DESC::value,
 													kerbal::type_traits::integral_constant<size_t, 3>,
 													typename kerbal::type_traits::conditional<
-															IS_INTRO_SORT_DESC::value,
-															kerbal::type_traits::integral_constant<size_t, 4>,
-															kerbal::type_traits::integral_constant<size_t, 5>
+															IS_RADIX_SORT_BY_KEY_ASC::value,
+															kerbal::type_traits::integral_constant<size_t, 6>,
+															typename kerbal::type_traits::conditional<
+																	IS_RADIX_SORT_BY_KEY_DESC::value,
+																	kerbal::type_traits::integral_constant<size_t, 7>,
+																	typename kerbal::type_traits::conditional<
+																			IS_INTRO_SORT_DESC::value,
+																			kerbal::type_traits::integral_constant<size_t, 4>,
+																			kerbal::type_traits::integral_constant<size_t, 5>
+																	>::type
+															>::type
 													>::type
 											>::type
 									>::type
@@ -129,36 +207,95 @@ namespace kerbal
 			}
 
 			template <typename ForwardIterator, typename Compare>
-			void sort(ForwardIterator first, ForwardIterator last, Compare,
+			KERBAL_CONSTEXPR14
+			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
+						kerbal::type_traits::integral_constant<size_t, 4>)
+			{
+				kerbal::algorithm::intro_sort(first, last, compare);
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
+						kerbal::type_traits::integral_constant<size_t, 5>)
+			{
+				kerbal::algorithm::stable_sort(first, last, compare);
+			}
+
+			/*
+			 * Radix sort can't be evaluated at compile time (memcpy, allocator), so the comparison sort is taken
+			 * then instead. Without the compiler support to tell the compile time from the run time, only the
+			 * floating point, which went to the comparison sort before it could be radix sorted, does so.
+			 */
+			template <typename ForwardIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			bool sort_radix_sort_use_compare_sort() KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type value_type;
+				return (KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT || kerbal::type_traits::is_floating_point<value_type>::value) &&
+						KERBAL_MAY_BE_CONSTANT_EVALUATED();
+			}
+
+			template <typename ForwardIterator, typename Compare>
+			struct sort_radix_sort_fallback_policy:
+					kerbal::type_traits::integral_constant<size_t,
+						kerbal::iterator::is_random_access_compatible_iterator<ForwardIterator>::value ? 4 : 5
+					>
+			{
+			};
+
+			template <typename ForwardIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
 						kerbal::type_traits::integral_constant<size_t, 2>)
 			{
+				if (sort_radix_sort_use_compare_sort<ForwardIterator, Compare>()) {
+					kerbal::algorithm::detail::sort(first, last, compare,
+							sort_radix_sort_fallback_policy<ForwardIterator, Compare>());
+					return;
+				}
 				kerbal::algorithm::radix_sort(first, last, kerbal::type_traits::false_type());
 			}
 
 			template <typename ForwardIterator, typename Compare>
-			void sort(ForwardIterator first, ForwardIterator last, Compare,
+			KERBAL_CONSTEXPR14
+			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
 						kerbal::type_traits::integral_constant<size_t, 3>)
 			{
+				if (sort_radix_sort_use_compare_sort<ForwardIterator, Compare>()) {
+					kerbal::algorithm::detail::sort(first, last, compare,
+							sort_radix_sort_fallback_policy<ForwardIterator, Compare>());
+					return;
+				}
 				kerbal::algorithm::radix_sort(first, last, kerbal::type_traits::true_type());
 			}
 
 			template <typename ForwardIterator, typename Compare>
-			KERBAL_CONSTEXPR14
 			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
-						kerbal::type_traits::integral_constant<size_t, 4>)
+						kerbal::type_traits::integral_constant<size_t, 6>)
 			{
-				kerbal::algorithm::intro_sort(first, last, compare);
+				typedef sort_compare_by_key_extract<typename Compare::key_type, typename Compare::extract_type> extract;
+				kerbal::algorithm::radix_sort_by_key(first, last, extract(compare.extract), kerbal::type_traits::false_type());
 			}
 
 			template <typename ForwardIterator, typename Compare>
 			void sort(ForwardIterator first, ForwardIterator last, Compare compare,
-						kerbal::type_traits::integral_constant<size_t, 5>)
+						kerbal::type_traits::integral_constant<size_t, 7>)
 			{
-				kerbal::algorithm::stable_sort(first, last, compare);
+				typedef sort_compare_by_key_extract<typename Compare::key_type, typename Compare::extract_type> extract;
+				kerbal::algorithm::radix_sort_by_key(first, last, extract(compare.extract), kerbal::type_traits::true_type());
 			}
 
 		} // namespace detail
 
+		/**
+		 * @brief Sort [first, last) by pigeonhole sort, radix sort or the comparison sort, chosen by the types.
+		 *
+		 * Radix sort can't run in the constant evaluation, so the comparison sort is taken there.
+		 * @warning Since C++14, on the compilers without __builtin_is_constant_evaluated (gcc and clang before
+		 *          9), the constant evaluation can't be told from the run time, so the floating points are
+		 *          always sorted by the comparison sort to keep sort usable in the constant expressions, while
+		 *          the integers are always radix sorted and hence can't be sorted in the constant expressions.
+		 */
 		template <typename ForwardIterator, typename Compare>
 		KERBAL_CONSTEXPR14
 		void sort(ForwardIterator first, ForwardIterator last, Compare compare)
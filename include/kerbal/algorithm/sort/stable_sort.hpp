@@ -15,6 +15,7 @@
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/algorithm/sort/insertion_sort.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/memory/allocator_traits.hpp>
 
@@ -64,6 +65,29 @@ namespace kerbal
 				return false;
 			}
 
+			/*
+			 * merge_sort_merge takes *mid only if cmp(*mid, *buffer_first). When the buffer holds the latter half,
+			 * the former half has to win the ties to keep the sort stable.
+			 */
+			template <typename Compare>
+			struct stable_sort_not_greater_compare
+			{
+					Compare & cmp;
+
+					KERBAL_CONSTEXPR
+					explicit stable_sort_not_greater_compare(Compare & cmp) KERBAL_NOEXCEPT :
+							cmp(cmp)
+					{
+					}
+
+					template <typename Tp, typename Up>
+					KERBAL_CONSTEXPR
+					bool operator()(const Tp & lhs, const Up & rhs) const
+					{
+						return !static_cast<bool>(cmp(rhs, lhs));
+					}
+			};
+
 		} // namespace detail
 
 		/*
@@ -100,7 +124,8 @@ namespace kerbal
 			const iterator t(kerbal::iterator::next(b_end, static_cast<size_t>(second_half_len - first_half_len)));
 			kerbal::algorithm::merge(first, a_end, a_end, b_end, t, cmp);
 
-			kerbal::algorithm::detail::merge_sort_merge(buffer, buffer_end, t, d_end, first, cmp);
+			kerbal::algorithm::detail::merge_sort_merge(buffer, buffer_end, t, d_end, first,
+											detail::stable_sort_not_greater_compare<Compare>(cmp));
 			return d_end;
 		}
 
@@ -0,0 +1,543 @@
+/**
+ * @file       tim_sort.hpp
+ * @brief
+ * @date       2020-08-28
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_TIM_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_TIM_SORT_HPP
+
+#include <kerbal/algorithm/binary_search.hpp>
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/iterator/reverse_iterator.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/operators/generic_assign.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <memory>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * the runs shorter than it are extended by insertion sort
+			 * returns k in [32, 64], so that n / k is equal to or a bit less than a power of 2
+			 */
+			template <typename Size>
+			Size tim_sort_min_run(Size n) KERBAL_NOEXCEPT
+			{
+				Size r = 0;
+				while (n >= 64) {
+					r |= n & 1;
+					n >>= 1;
+				}
+				return n + r;
+			}
+
+			/*
+			 * Length of the run beginning at first. A strictly descending run is reversed in place,
+			 * the strictness keeps the sort stable.
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type
+			tim_sort_count_run_and_make_ascending(RandomAccessIterator first, RandomAccessIterator last, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+
+				iterator run_last(first + 1);
+				if (run_last == last) {
+					return 1;
+				}
+
+				if (cmp(*run_last, *first)) {
+					++run_last;
+					while (run_last != last && cmp(*run_last, *(run_last - 1))) {
+						++run_last;
+					}
+					kerbal::algorithm::reverse(first, run_last);
+				} else {
+					++run_last;
+					while (run_last != last && !cmp(*run_last, *(run_last - 1))) {
+						++run_last;
+					}
+				}
+				return run_last - first;
+			}
+
+			/*
+			 * [first, start) is sorted, insert each of [start, last) into it by binary search
+			 */
+			template <typename RandomAccessIterator, typename Compare>
+			void tim_sort_binary_insertion_sort(RandomAccessIterator first, RandomAccessIterator start,
+												RandomAccessIterator last, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+
+				for (; start != last; ++start) {
+					iterator pos(kerbal::algorithm::upper_bound(first, start, *start, cmp));
+					if (pos != start) {
+						detail::insertion_sort_rotate_to(pos, start);
+					}
+				}
+			}
+
+			/*
+			 * Exponential search from the left end.
+			 * @return the offset of the first element in [first, first + len) which is greater than value
+			 */
+			template <typename RandomAccessIterator, typename Tp, typename Compare>
+			typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type
+			tim_sort_gallop_upper(RandomAccessIterator first,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+								const Tp & value, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				if (cmp(value, *first)) {
+					return 0;
+				}
+				difference_type last_ofs = 0;
+				difference_type ofs = 1;
+				while (ofs < len && !cmp(value, first[ofs])) {
+					last_ofs = ofs;
+					ofs = (ofs << 1) + 1;
+					if (ofs <= 0) { // overflow
+						ofs = len;
+					}
+				}
+				if (ofs > len) {
+					ofs = len;
+				}
+				// first[last_ofs] <= value < first[ofs]
+				return kerbal::algorithm::upper_bound(first + (last_ofs + 1), first + ofs, value, cmp) - first;
+			}
+
+			/*
+			 * Exponential search from the left end.
+			 * @return the offset of the first element in [first, first + len) which is not less than value
+			 */
+			template <typename RandomAccessIterator, typename Tp, typename Compare>
+			typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type
+			tim_sort_gallop_lower(RandomAccessIterator first,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+								const Tp & value, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				if (!cmp(*first, value)) {
+					return 0;
+				}
+				difference_type last_ofs = 0;
+				difference_type ofs = 1;
+				while (ofs < len && cmp(first[ofs], value)) {
+					last_ofs = ofs;
+					ofs = (ofs << 1) + 1;
+					if (ofs <= 0) { // overflow
+						ofs = len;
+					}
+				}
+				if (ofs > len) {
+					ofs = len;
+				}
+				// first[last_ofs] < value <= first[ofs]
+				return kerbal::algorithm::lower_bound(first + (last_ofs + 1), first + ofs, value, cmp) - first;
+			}
+
+			/*
+			 * Exponential search from the right end.
+			 * @return the offset of the first element in [first, first + len) which is not less than value
+			 */
+			template <typename RandomAccessIterator, typename Tp, typename Compare>
+			typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type
+			tim_sort_gallop_lower_backward(RandomAccessIterator first,
+										typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+										const Tp & value, Compare & cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				if (cmp(first[len - 1], value)) {
+					return len;
+				}
+				difference_type last_ofs = 0;
+				difference_type ofs = 1;
+				while (ofs < len && !cmp(first[len - 1 - ofs], value)) {
+					last_ofs = ofs;
+					ofs = (ofs << 1) + 1;
+					if (ofs <= 0) { // overflow
+						ofs = len;
+					}
+				}
+				if (ofs > len) {
+					ofs = len;
+				}
+				// first[len - 1 - ofs] < value <= first[len - 1 - last_ofs]
+				return kerbal::algorithm::lower_bound(first + (len - ofs), first + (len - 1 - last_ofs), value, cmp) - first;
+			}
+
+			template <typename Compare>
+			struct tim_sort_reverse_compare
+			{
+					Compare & cmp;
+
+					explicit tim_sort_reverse_compare(Compare & cmp) KERBAL_NOEXCEPT :
+							cmp(cmp)
+					{
+					}
+
+					template <typename Tp, typename Up>
+					bool operator()(const Tp & lhs, const Up & rhs) const
+					{
+						return cmp(rhs, lhs);
+					}
+			};
+
+			/*
+			 * the initial number of wins in a row of one run to enter the galloping mode
+			 */
+			template <typename RandomAccessIterator>
+			struct tim_sort_min_gallop:
+					kerbal::type_traits::integral_constant<
+						typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type, 7
+					>
+			{
+			};
+
+			/*
+			 * Merge [buffer_first, buffer_last) and [mid, last) to the range ending at mid and beginning at `to`,
+			 * the elements in the buffer win the ties.
+			 *
+			 * One by one merging is done while the two runs win in turn. Once a run wins min_gallop times in a row,
+			 * the merge enters the galloping mode, in which the lengths of the winning streaks are found by
+			 * exponential search and moved in batch, and leaves it once the streaks get shorter than MIN_GALLOP.
+			 * min_gallop is adapted: lowered while galloping pays, raised when it doesn't, and kept for the
+			 * following merges.
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+			void tim_sort_gallop_merge(RandomAccessIterator2 buffer_first, RandomAccessIterator2 buffer_last,
+										RandomAccessIterator mid, RandomAccessIterator last,
+										RandomAccessIterator to, Compare cmp,
+										typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type & min_gallop)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type MIN_GALLOP = tim_sort_min_gallop<iterator>::value;
+
+				while (true) {
+					difference_type count1 = 0; // wins of the buffer in a row
+					difference_type count2 = 0; // wins of [mid, last) in a row
+
+					do {
+						if (cmp(*mid, *buffer_first)) {
+							kerbal::operators::generic_assign(*to, *mid); // *to = *mid;
+							++to;
+							++mid;
+							++count2;
+							count1 = 0;
+							if (mid == last) {
+								kerbal::algorithm::copy(buffer_first, buffer_last, to);
+								return;
+							}
+						} else {
+							kerbal::operators::generic_assign(*to, *buffer_first); // *to = *buffer_first;
+							++to;
+							++buffer_first;
+							++count1;
+							count2 = 0;
+							if (buffer_first == buffer_last) {
+								return; // the rest of [mid, last) is in place
+							}
+						}
+					} while ((count1 | count2) < min_gallop);
+
+					do {
+						count1 = detail::tim_sort_gallop_upper(buffer_first, buffer_last - buffer_first, *mid, cmp);
+						to = kerbal::algorithm::copy(buffer_first, buffer_first + count1, to);
+						buffer_first += count1;
+						if (buffer_first == buffer_last) {
+							return;
+						}
+						// *mid < *buffer_first now
+						kerbal::operators::generic_assign(*to, *mid); // *to = *mid;
+						++to;
+						++mid;
+						if (mid == last) {
+							kerbal::algorithm::copy(buffer_first, buffer_last, to);
+							return;
+						}
+
+						count2 = detail::tim_sort_gallop_lower(mid, last - mid, *buffer_first, cmp);
+						to = kerbal::algorithm::copy(mid, mid + count2, to);
+						mid += count2;
+						if (mid == last) {
+							kerbal::algorithm::copy(buffer_first, buffer_last, to);
+							return;
+						}
+						// *buffer_first <= *mid now
+						kerbal::operators::generic_assign(*to, *buffer_first); // *to = *buffer_first;
+						++to;
+						++buffer_first;
+						if (buffer_first == buffer_last) {
+							return;
+						}
+
+						if (min_gallop > 1) {
+							--min_gallop;
+						}
+					} while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+					min_gallop += 2; // penalty for leaving the galloping mode
+				}
+			}
+
+			/*
+			 * Merge the adjacent runs [first, mid) and [mid, last) by the buffer, which should be able to hold
+			 * the shorter one of them after trimming.
+			 */
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+			void tim_sort_merge(RandomAccessIterator first, RandomAccessIterator mid, RandomAccessIterator last,
+								RandomAccessIterator2 buffer, Compare & cmp,
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type & min_gallop)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				// the elements in the first run not greater than *mid are already in place
+				first += detail::tim_sort_gallop_upper(first, mid - first, *mid, cmp);
+				if (first == mid) {
+					return;
+				}
+				// so do the elements in the second run not less than *(mid - 1)
+				last = mid + detail::tim_sort_gallop_lower_backward(mid, last - mid, *(mid - 1), cmp);
+				if (mid == last) {
+					return;
+				}
+
+				difference_type len1(mid - first);
+				difference_type len2(last - mid);
+				if (len1 <= len2) {
+					RandomAccessIterator2 buffer_last(kerbal::algorithm::copy(first, mid, buffer));
+					detail::tim_sort_gallop_merge(buffer, buffer_last, mid, last, first, cmp, min_gallop);
+				} else {
+					// merge from the back to the front, the elements in the second run win the ties
+					RandomAccessIterator2 buffer_last(kerbal::algorithm::copy(mid, last, buffer));
+					detail::tim_sort_gallop_merge(
+							kerbal::iterator::make_reverse_iterator(buffer_last),
+							kerbal::iterator::make_reverse_iterator(buffer),
+							kerbal::iterator::make_reverse_iterator(mid),
+							kerbal::iterator::make_reverse_iterator(first),
+							kerbal::iterator::make_reverse_iterator(last),
+							tim_sort_reverse_compare<Compare>(cmp), min_gallop);
+				}
+			}
+
+			template <typename RandomAccessIterator, typename RandomAccessIterator2, typename Compare>
+			void tim_sort_afford_buffer(RandomAccessIterator first, RandomAccessIterator last,
+										RandomAccessIterator2 buffer, Compare cmp, std::random_access_iterator_tag)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				difference_type n(kerbal::iterator::distance(first, last));
+				if (n < 2) {
+					return;
+				}
+
+				const difference_type min_run(detail::tim_sort_min_run(n));
+
+				/*
+				 * Runs pending to be merged. The lengths keep
+				 * run_len[i - 2] > run_len[i - 1] + run_len[i] and run_len[i - 1] > run_len[i],
+				 * so there are no more than log_phi(n) of them.
+				 */
+				iterator run_base[sizeof(difference_type) * CHAR_BIT * 2];
+				difference_type run_len[sizeof(difference_type) * CHAR_BIT * 2];
+				size_t run_num = 0;
+				difference_type min_gallop(tim_sort_min_gallop<iterator>::value);
+
+				iterator lo(first);
+				while (lo != last) {
+					difference_type remain(last - lo);
+					difference_type len(detail::tim_sort_count_run_and_make_ascending(lo, last, cmp));
+					if (len < min_run) {
+						difference_type force(remain < min_run ? remain : min_run);
+						detail::tim_sort_binary_insertion_sort(lo, lo + len, lo + force, cmp);
+						len = force;
+					}
+
+					run_base[run_num] = lo;
+					run_len[run_num] = len;
+					++run_num;
+					lo += len;
+
+					// restore the invariants of the run lengths
+					while (run_num > 1) {
+						size_t k = run_num - 2;
+						if ((k > 0 && run_len[k - 1] <= run_len[k] + run_len[k + 1]) ||
+							(k > 1 && run_len[k - 2] <= run_len[k - 1] + run_len[k])) {
+							if (run_len[k - 1] < run_len[k + 1]) {
+								--k;
+							}
+						} else if (run_len[k] > run_len[k + 1]) {
+							break;
+						}
+						detail::tim_sort_merge(run_base[k], run_base[k + 1], run_base[k + 1] + run_len[k + 1], buffer, cmp, min_gallop);
+						run_len[k] += run_len[k + 1];
+						if (k + 3 == run_num) {
+							run_base[k + 1] = run_base[k + 2];
+							run_len[k + 1] = run_len[k + 2];
+						}
+						--run_num;
+					}
+				}
+
+				while (run_num > 1) {
+					size_t k = run_num - 2;
+					if (k > 0 && run_len[k - 1] < run_len[k + 1]) {
+						--k;
+					}
+					detail::tim_sort_merge(run_base[k], run_base[k + 1], run_base[k + 1] + run_len[k + 1], buffer, cmp, min_gallop);
+					run_len[k] += run_len[k + 1];
+					if (k + 3 == run_num) {
+						run_base[k + 1] = run_base[k + 2];
+						run_len[k + 1] = run_len[k + 2];
+					}
+					--run_num;
+				}
+			}
+
+			template <typename ForwardIterator, typename ForwardIterator2, typename Compare>
+			void tim_sort_afford_buffer(ForwardIterator first, ForwardIterator last,
+										ForwardIterator2 buffer, Compare cmp, std::forward_iterator_tag)
+			{
+				kerbal::algorithm::stable_sort_afford_buffer(first, last, buffer, cmp);
+			}
+
+		} // namespace detail
+
+		/*
+		 * Natural merge sort (Timsort): the ascending and strictly descending runs already in [first, last) are
+		 * found and merged, so that the nearly sorted ranges are sorted in close to linear time.
+		 * The sort is stable.
+		 * The buffer should be able to hold (n + 1) / 2 elements.
+		 * Not random access ranges are sorted by stable_sort_afford_buffer.
+		 */
+		template <typename ForwardIterator, typename ForwardIterator2, typename Compare>
+		void tim_sort_afford_buffer(ForwardIterator first, ForwardIterator last, ForwardIterator2 buffer, Compare cmp)
+		{
+			kerbal::algorithm::detail::tim_sort_afford_buffer(first, last, buffer, cmp,
+																kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator, typename ForwardIterator2>
+		void tim_sort_afford_buffer(ForwardIterator first, ForwardIterator last, ForwardIterator2 buffer)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::tim_sort_afford_buffer(first, last, buffer, std::less<value_type>());
+		}
+
+		/*
+		 * The buffer got from the allocator is copy constructed from the front of [first, last), so value_type
+		 * needn't be default constructible.
+		 */
+		template <typename ForwardIterator, typename Allocator, typename Compare>
+		void tim_sort_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator, Compare cmp)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			typedef kerbal::memory::allocator_traits<Allocator> allocator_traits;
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			difference_type buffer_length(len - len / 2);
+			if (buffer_length == 0) {
+				return;
+			}
+			value_type * const buffer = allocator_traits::allocate(allocator, buffer_length);
+			value_type * k = buffer;
+
+			struct dealloc_helper
+			{
+					Allocator & allocator;
+					difference_type const & buffer_length;
+					value_type * const & buffer;
+					value_type * & k;
+
+					dealloc_helper(Allocator & allocator, difference_type const & buffer_length, value_type * const & buffer, value_type * & k) KERBAL_NOEXCEPT :
+							allocator(allocator), buffer_length(buffer_length), buffer(buffer), k(k)
+					{
+					}
+
+					~dealloc_helper()
+					{
+						while (k != buffer) {
+							--k;
+							allocator_traits::destroy(this->allocator, k);
+						}
+						allocator_traits::deallocate(this->allocator, buffer, buffer_length);
+					}
+			} auto_dealloc_helper(allocator, buffer_length, buffer, k);
+
+			iterator it(first);
+			while (k != buffer + buffer_length) {
+				allocator_traits::construct(allocator, k, *it);
+				++k;
+				++it;
+			}
+
+			kerbal::algorithm::tim_sort_afford_buffer(first, last, buffer, cmp);
+		}
+
+		template <typename ForwardIterator, typename Allocator>
+		void tim_sort_afford_allocator(ForwardIterator first, ForwardIterator last, Allocator & allocator)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::tim_sort_afford_allocator(first, last, allocator, std::less<value_type>());
+		}
+
+		template <typename ForwardIterator, typename Compare>
+		void tim_sort(ForwardIterator first, ForwardIterator last, Compare cmp)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			std::allocator<value_type> allocator;
+			kerbal::algorithm::tim_sort_afford_allocator(first, last, allocator, cmp);
+		}
+
+		template <typename ForwardIterator>
+		void tim_sort(ForwardIterator first, ForwardIterator last)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::tim_sort(first, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_TIM_SORT_HPP
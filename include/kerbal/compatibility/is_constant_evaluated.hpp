@@ -0,0 +1,45 @@
+/**
+ * @file       is_constant_evaluated.hpp
+ * @brief
+ * @date       2020-09-09
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
+#define KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+
+
+#ifndef KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT
+#	if defined(__has_builtin)
+#		if __has_builtin(__builtin_is_constant_evaluated)
+#			define KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT 1
+#		endif
+#	endif
+#endif
+
+#ifndef KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT
+#	define KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT 0
+#endif
+
+/*
+ * Whether the evaluation may happen at compile time, for guarding the code which can't be evaluated then
+ * (memcpy, intrinsics, ...). Without the compiler support, it is conservatively true in the C++14 constexpr
+ * functions, and false before C++14, in which they are not constexpr.
+ */
+#ifndef KERBAL_MAY_BE_CONSTANT_EVALUATED
+#	if !KERBAL_ENABLE_CONSTEXPR14
+#		define KERBAL_MAY_BE_CONSTANT_EVALUATED() false
+#	elif KERBAL_HAS_IS_CONSTANT_EVALUATED_SUPPORT
+#		define KERBAL_MAY_BE_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#	else
+#		define KERBAL_MAY_BE_CONSTANT_EVALUATED() true
+#	endif
+#endif
+
+#endif // KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
@@ -0,0 +1,166 @@
+/**
+ * @file       addressable_priority_queue.hpp
+ * @brief
+ * @date       2020-09-04
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_ADDRESSABLE_PRIORITY_QUEUE_HPP
+#define KERBAL_CONTAINER_ADDRESSABLE_PRIORITY_QUEUE_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/container/detail/addressable_priority_queue_base.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/enable_if.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if __cplusplus >= 201103L
+#	include <initializer_list>
+#endif
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			template <typename Tp, typename KeyCompare, typename Allocator>
+			struct addressable_priority_queue_helper
+			{
+				private:
+					typedef kerbal::memory::allocator_traits<Allocator>		tp_allocator_traits;
+					typedef typename tp_allocator_traits::template rebind_alloc<size_t>::other	index_allocator_type;
+
+				public:
+					typedef kerbal::container::detail::addressable_priority_queue_base<
+							Tp, KeyCompare, std::vector<Tp, Allocator>, std::vector<size_t, index_allocator_type>
+					> type;
+			};
+
+		} // namespace detail
+
+		/**
+		 * @brief Priority queue on std::vector, each element of which can be accessed, updated and erased in O(log n)
+		 *        by the handle returned when it was pushed. The handles are reused after the elements are popped or
+		 *        erased, so they keep less than the max size the queue has ever reached.
+		 */
+		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp> >
+		class addressable_priority_queue:
+				public kerbal::container::detail::addressable_priority_queue_helper<Tp, KeyCompare, Allocator>::type
+		{
+			private:
+				typedef typename kerbal::container::detail::addressable_priority_queue_helper<
+						Tp, KeyCompare, Allocator
+				>::type super;
+
+			public:
+				typedef typename super::container_type			container_type;
+				typedef typename super::value_compare			value_compare;
+
+				typedef typename super::value_type				value_type;
+				typedef typename super::const_type				const_type;
+				typedef typename super::reference				reference;
+				typedef typename super::const_reference			const_reference;
+				typedef typename super::pointer					pointer;
+				typedef typename super::const_pointer			const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef typename super::rvalue_reference		rvalue_reference;
+				typedef typename super::const_rvalue_reference	const_rvalue_reference;
+#		endif
+
+				typedef typename super::size_type				size_type;
+				typedef typename super::difference_type			difference_type;
+
+				typedef typename super::const_iterator			const_iterator;
+				typedef typename super::const_reverse_iterator	const_reverse_iterator;
+
+				typedef typename super::handle_type				handle_type;
+
+				typedef Allocator								allocator_type;
+
+				KERBAL_CONSTEXPR20
+				addressable_priority_queue() :
+						super()
+				{
+				}
+
+				KERBAL_CONSTEXPR20
+				explicit addressable_priority_queue(value_compare kc) :
+						super(kc)
+				{
+				}
+
+				/**
+				 * @brief The handle of the i-th element of [first, last) is i.
+				 */
+				template <typename InputIterator>
+				KERBAL_CONSTEXPR20
+				addressable_priority_queue(InputIterator first, InputIterator last,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+								int
+						>::type = 0) :
+						super(first, last, value_compare())
+				{
+				}
+
+				template <typename InputIterator>
+				KERBAL_CONSTEXPR20
+				addressable_priority_queue(InputIterator first, InputIterator last, value_compare kc,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+								int
+						>::type = 0) :
+						super(first, last, kc)
+				{
+				}
+
+#		if __cplusplus >= 201103L
+
+				KERBAL_CONSTEXPR20
+				addressable_priority_queue(std::initializer_list<value_type> src) :
+						addressable_priority_queue(src.begin(), src.end())
+				{
+				}
+
+				KERBAL_CONSTEXPR20
+				addressable_priority_queue(std::initializer_list<value_type> src, value_compare kc) :
+						addressable_priority_queue(src.begin(), src.end(), kc)
+				{
+				}
+
+#		endif
+
+				void reserve(size_type new_cap)
+				{
+					this->c.reserve(new_cap);
+					this->handle_of.reserve(new_cap);
+					this->pos_of.reserve(new_cap);
+				}
+
+				KERBAL_CONSTEXPR20
+				void swap(addressable_priority_queue & with)
+				{
+					this->__swap(with);
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_ADDRESSABLE_PRIORITY_QUEUE_HPP
@@ -0,0 +1,470 @@
+/**
+ * @file       addressable_priority_queue_base.hpp
+ * @brief
+ * @date       2020-09-04
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_ADDRESSABLE_PRIORITY_QUEUE_BASE_HPP
+#define KERBAL_CONTAINER_DETAIL_ADDRESSABLE_PRIORITY_QUEUE_BASE_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Binary heap whose elements can be accessed, modified and erased by the handles returned by push.
+			 *
+			 * The elements are kept in heap order in c. handle_of[i] is the handle of c[i] and pos_of is the inverse
+			 * permutation of handle_of. The positions in [c.size(), handle_of.size()) keep the free handles, which are
+			 * reused by the later pushes, so that no free list is needed.
+			 */
+			template <typename Tp, typename KeyCompare, typename Sequence, typename IndexSequence>
+			class addressable_priority_queue_base
+			{
+				public:
+					typedef Sequence									container_type;
+					typedef KeyCompare									value_compare;
+
+					typedef Tp							value_type;
+					typedef const value_type			const_type;
+					typedef value_type&					reference;
+					typedef const value_type&			const_reference;
+					typedef value_type*					pointer;
+					typedef const value_type*			const_pointer;
+
+#			if __cplusplus >= 201103L
+					typedef value_type&&				rvalue_reference;
+					typedef const value_type&&			const_rvalue_reference;
+#			endif
+
+					typedef typename container_type::size_type					size_type;
+					typedef typename container_type::difference_type			difference_type;
+
+					typedef typename container_type::const_iterator				const_iterator;
+					typedef typename container_type::const_reverse_iterator		const_reverse_iterator;
+
+					typedef size_type					handle_type;
+
+				protected:
+					container_type c;
+					IndexSequence handle_of;
+					IndexSequence pos_of;
+					value_compare vc;
+
+					KERBAL_CONSTEXPR14
+					addressable_priority_queue_base() :
+							c(), handle_of(), pos_of(), vc()
+					{
+					}
+
+					KERBAL_CONSTEXPR14
+					explicit addressable_priority_queue_base(value_compare kc) :
+							c(), handle_of(), pos_of(), vc(kc)
+					{
+					}
+
+					template <typename InputIterator>
+					KERBAL_CONSTEXPR14
+					addressable_priority_queue_base(InputIterator first, InputIterator last, value_compare kc) :
+							c(first, last), handle_of(), pos_of(), vc(kc)
+					{
+						for (size_type i = 0; i < c.size(); ++i) {
+							handle_of.push_back(i);
+							pos_of.push_back(i);
+						}
+						for (size_type i = c.size() / 2; i > 0; --i) {
+							this->__sift_down(i - 1);
+						}
+					}
+
+					KERBAL_CONSTEXPR14
+					void __place(size_type i, handle_type h) KERBAL_NOEXCEPT
+					{
+						handle_of[i] = h;
+						pos_of[h] = i;
+					}
+
+					KERBAL_CONSTEXPR14
+					void __sift_up(size_type i)
+					{
+						if (i == 0) {
+							return;
+						}
+						size_type parent = (i - 1) / 2;
+						if (!vc(c[parent], c[i])) {
+							return;
+						}
+						value_type tmp(kerbal::compatibility::to_xvalue(c[i]));
+						handle_type h = handle_of[i];
+						do {
+							c[i] = kerbal::compatibility::to_xvalue(c[parent]);
+							this->__place(i, handle_of[parent]);
+							i = parent;
+							if (i == 0) {
+								break;
+							}
+							parent = (i - 1) / 2;
+						} while (vc(c[parent], tmp));
+						c[i] = kerbal::compatibility::to_xvalue(tmp);
+						this->__place(i, h);
+					}
+
+					KERBAL_CONSTEXPR14
+					void __sift_down(size_type i)
+					{
+						size_type len = c.size();
+						size_type child = 2 * i + 1;
+						if (child >= len) {
+							return;
+						}
+						value_type tmp(kerbal::compatibility::to_xvalue(c[i]));
+						handle_type h = handle_of[i];
+						do {
+							if (child + 1 < len && vc(c[child], c[child + 1])) {
+								++child;
+							}
+							if (!vc(tmp, c[child])) {
+								break;
+							}
+							c[i] = kerbal::compatibility::to_xvalue(c[child]);
+							this->__place(i, handle_of[child]);
+							i = child;
+							child = 2 * i + 1;
+						} while (child < len);
+						c[i] = kerbal::compatibility::to_xvalue(tmp);
+						this->__place(i, h);
+					}
+
+					KERBAL_CONSTEXPR14
+					void __adjust(size_type i)
+					{
+						if (i != 0 && vc(c[(i - 1) / 2], c[i])) {
+							this->__sift_up(i);
+						} else {
+							this->__sift_down(i);
+						}
+					}
+
+					/*
+					 * make sure that handle_of[size()] is a free handle before pushing an element
+					 */
+					KERBAL_CONSTEXPR14
+					handle_type __reserve_handle()
+					{
+						size_type pos = c.size();
+						if (pos == handle_of.size()) {
+							if (pos == pos_of.size()) { // may be not after the last push_back to handle_of threw
+								pos_of.push_back(pos);
+							}
+							handle_of.push_back(pos);
+						}
+						return handle_of[pos];
+					}
+
+					KERBAL_CONSTEXPR14
+					void __erase_at(size_type i)
+					{
+						size_type back = c.size() - 1;
+						if (i != back) {
+							c[i] = kerbal::compatibility::to_xvalue(c[back]);
+							handle_type h = handle_of[i];
+							this->__place(i, handle_of[back]);
+							this->__place(back, h);
+						}
+						c.pop_back();
+						if (i != back) {
+							this->__adjust(i);
+						}
+					}
+
+					KERBAL_CONSTEXPR14
+					void __swap(addressable_priority_queue_base & with)
+					{
+						this->c.swap(with.c);
+						this->handle_of.swap(with.handle_of);
+						this->pos_of.swap(with.pos_of);
+						kerbal::algorithm::swap(this->vc, with.vc);
+					}
+
+				public:
+
+					KERBAL_CONSTEXPR
+					bool empty() const
+					{
+						return c.empty();
+					}
+
+					KERBAL_CONSTEXPR
+					size_type size() const
+					{
+						return c.size();
+					}
+
+					KERBAL_CONSTEXPR
+					size_type max_size() const
+					{
+						return c.max_size();
+					}
+
+					KERBAL_CONSTEXPR14
+					const_reference top() const
+					{
+						return c.front();
+					}
+
+					KERBAL_CONSTEXPR14
+					handle_type top_handle() const
+					{
+						return handle_of[0];
+					}
+
+					/**
+					 * @brief Whether h refers to an element in the queue, which is false after it has been popped or erased.
+					 */
+					KERBAL_CONSTEXPR14
+					bool contains(handle_type h) const
+					{
+						return h < handle_of.size() && pos_of[h] < c.size();
+					}
+
+					/**
+					 * @require contains(h)
+					 */
+					KERBAL_CONSTEXPR14
+					const_reference get(handle_type h) const
+					{
+						return c[pos_of[h]];
+					}
+
+					/**
+					 * @brief Push val and return its handle, which keeps valid until the element is popped or erased.
+					 */
+					KERBAL_CONSTEXPR14
+					handle_type push(const_reference val)
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(val);
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+#			if __cplusplus >= 201103L
+
+					KERBAL_CONSTEXPR14
+					handle_type push(rvalue_reference val)
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(kerbal::compatibility::move(val));
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+					template <typename ... Args>
+					KERBAL_CONSTEXPR14
+					handle_type emplace(Args&& ... args)
+					{
+						handle_type h = this->__reserve_handle();
+						c.emplace_back(std::forward<Args>(args)...);
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+#			else
+
+					// std::vector has no emplace_back before C++11
+					handle_type emplace()
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(value_type());
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+					template <typename Arg0>
+					handle_type emplace(const Arg0& arg0)
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(value_type(arg0));
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+					template <typename Arg0, typename Arg1>
+					handle_type emplace(const Arg0& arg0, const Arg1& arg1)
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(value_type(arg0, arg1));
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+					template <typename Arg0, typename Arg1, typename Arg2>
+					handle_type emplace(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+					{
+						handle_type h = this->__reserve_handle();
+						c.push_back(value_type(arg0, arg1, arg2));
+						this->__sift_up(c.size() - 1);
+						return h;
+					}
+
+#			endif
+
+					KERBAL_CONSTEXPR14
+					void pop()
+					{
+						this->__erase_at(0);
+					}
+
+					/**
+					 * @brief Erase the element referred by h in O(log n).
+					 * @require contains(h)
+					 */
+					KERBAL_CONSTEXPR14
+					void erase(handle_type h)
+					{
+						this->__erase_at(pos_of[h]);
+					}
+
+					/**
+					 * @brief Replace the element referred by h with val, which may be either less or greater than it.
+					 * @require contains(h)
+					 */
+					KERBAL_CONSTEXPR14
+					void update(handle_type h, const_reference val)
+					{
+						size_type i = pos_of[h];
+						c[i] = val;
+						this->__adjust(i);
+					}
+
+					/**
+					 * @brief Replace the element referred by h with val, which is not less than it by value_compare,
+					 *        that is, val comes out earlier. With std::greater, it is the decrease-key of Dijkstra.
+					 * @require contains(h)
+					 */
+					KERBAL_CONSTEXPR14
+					void increase_key(handle_type h, const_reference val)
+					{
+						size_type i = pos_of[h];
+						c[i] = val;
+						this->__sift_up(i);
+					}
+
+					/**
+					 * @brief Replace the element referred by h with val, which is not greater than it by value_compare,
+					 *        that is, val comes out later.
+					 * @require contains(h)
+					 */
+					KERBAL_CONSTEXPR14
+					void decrease_key(handle_type h, const_reference val)
+					{
+						size_type i = pos_of[h];
+						c[i] = val;
+						this->__sift_down(i);
+					}
+
+					/**
+					 * @brief Erase all the elements, all the handles become invalid.
+					 */
+					KERBAL_CONSTEXPR14
+					void clear()
+					{
+						c.clear();
+					}
+
+					KERBAL_CONSTEXPR14
+					const value_compare & value_comp() const
+					{
+						return vc;
+					}
+
+					/**
+					 * @brief Iterators of the elements in heap order.
+					 */
+					KERBAL_CONSTEXPR
+					const_iterator begin() const
+					{
+						return c.begin();
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator end() const
+					{
+						return c.end();
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator cbegin() const
+					{
+						return c.begin();
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator cend() const
+					{
+						return c.end();
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator rbegin() const
+					{
+						return c.rbegin();
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator rend() const
+					{
+						return c.rend();
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator crbegin() const
+					{
+						return c.rbegin();
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator crend() const
+					{
+						return c.rend();
+					}
+
+					/**
+					 * @brief The handle of the element an iterator refers to.
+					 */
+					KERBAL_CONSTEXPR14
+					handle_type handle_of_iterator(const_iterator it) const
+					{
+						return handle_of[static_cast<size_type>(it - c.begin())];
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_ADDRESSABLE_PRIORITY_QUEUE_BASE_HPP
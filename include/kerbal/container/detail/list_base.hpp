@@ -152,6 +152,9 @@ namespace kerbal
 					KERBAL_CONSTEXPR20
 					static void __swap_type_unrelated(list_type_unrelated & lhs, list_type_unrelated & rhs) KERBAL_NOEXCEPT;
 
+					KERBAL_CONSTEXPR20
+					static void __merge_sort_relink(node_base * pre, node_base * start, node_base * post) KERBAL_NOEXCEPT;
+
 			};
 
 			template <typename Tp>
@@ -328,11 +331,7 @@ namespace kerbal
 				private:
 					template <typename BinaryPredict>
 					KERBAL_CONSTEXPR20
-					void merge_sort_merge(iterator first, iterator mid, iterator last, BinaryPredict cmp);
-
-					template <typename BinaryPredict>
-					KERBAL_CONSTEXPR20
-					iterator merge_sort_n(iterator first, difference_type len, BinaryPredict cmp);
+					static void merge_sort_merge(node_base * & a, node_base * b, BinaryPredict & cmp);
 
 				protected:
 					template <typename BinaryPredict>
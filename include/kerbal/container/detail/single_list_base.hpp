@@ -142,6 +142,10 @@ namespace kerbal
 					KERBAL_CONSTEXPR20
 					static void swap_with_empty(sl_type_unrelated & not_empty_list, sl_type_unrelated & empty_list) KERBAL_NOEXCEPT;
 
+					// pre-cond: start != NULL
+					KERBAL_CONSTEXPR20
+					void __merge_sort_relink(node_base * pre, node_base * start, node_base * back, node_base * post) KERBAL_NOEXCEPT;
+
 			};
 
 			template <typename Tp>
@@ -267,6 +271,27 @@ namespace kerbal
 					KERBAL_CONSTEXPR20
 					void reverse() KERBAL_NOEXCEPT;
 
+				private:
+					template <typename BinaryPredict>
+					KERBAL_CONSTEXPR20
+					static void merge_sort_merge(node_base * & a, node_base * & a_back,
+												node_base * b, node_base * b_back, BinaryPredict & cmp);
+
+				protected:
+					template <typename BinaryPredict>
+					KERBAL_CONSTEXPR20
+					void sort(iterator first, iterator last, BinaryPredict cmp);
+
+					KERBAL_CONSTEXPR20
+					void sort(iterator first, iterator last);
+
+					template <typename BinaryPredict>
+					KERBAL_CONSTEXPR20
+					void sort(BinaryPredict cmp);
+
+					KERBAL_CONSTEXPR20
+					void sort();
+
 					KERBAL_CONSTEXPR20
 					void swap_allocator_unrelated(sl_allocator_unrelated & ano) KERBAL_NOEXCEPT;
 
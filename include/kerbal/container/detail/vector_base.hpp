@@ -0,0 +1,876 @@
+/**
+ * @file       vector_base.hpp
+ * @brief
+ * @date       2020-09-07
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
+#define KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/assign/ilist.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/data_struct/raw_storage.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/iterator/reverse_iterator.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/can_be_empty_base.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/enable_if.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#	include <initializer_list>
+#	include <type_traits>
+#endif
+
+#include <kerbal/container/detail/static_vector_iterator.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			template <typename Tp>
+			class vector_allocator_unrelated
+			{
+				protected:
+					typedef Tp							value_type;
+					typedef const value_type			const_type;
+					typedef value_type&					reference;
+					typedef const value_type&			const_reference;
+					typedef value_type*					pointer;
+					typedef const value_type*			const_pointer;
+
+#			if __cplusplus >= 201103L
+					typedef value_type&&				rvalue_reference;
+					typedef const value_type&&			const_rvalue_reference;
+#			endif
+
+					typedef std::size_t					size_type;
+					typedef std::ptrdiff_t				difference_type;
+
+					typedef kerbal::container::detail::__stavec_iter<value_type>		iterator;
+					typedef kerbal::container::detail::__stavec_kiter<value_type>		const_iterator;
+					typedef kerbal::iterator::reverse_iterator<iterator>				reverse_iterator;
+					typedef kerbal::iterator::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+					typedef kerbal::data_struct::raw_storage<value_type>				storage_type;
+
+				protected:
+					storage_type * k_buffer;
+					size_type k_size;
+					size_type k_capacity;
+
+					KERBAL_CONSTEXPR
+					vector_allocator_unrelated() KERBAL_NOEXCEPT
+							: k_buffer(NULL), k_size(0), k_capacity(0)
+					{
+					}
+
+				//===================
+				//element access
+
+					KERBAL_CONSTEXPR14
+					reference operator[](size_type index) KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[index].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					const_reference operator[](size_type index) const KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[index].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					reference front() KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[0].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					const_reference front() const KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[0].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					reference back() KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[this->k_size - 1].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					const_reference back() const KERBAL_NOEXCEPT
+					{
+						return this->k_buffer[this->k_size - 1].raw_value();
+					}
+
+					KERBAL_CONSTEXPR14
+					pointer data() KERBAL_NOEXCEPT
+					{
+						return this->k_buffer == NULL ? NULL : this->k_buffer[0].raw_pointer();
+					}
+
+					KERBAL_CONSTEXPR14
+					const_pointer data() const KERBAL_NOEXCEPT
+					{
+						return this->k_buffer == NULL ? NULL : this->k_buffer[0].raw_pointer();
+					}
+
+				//===================
+				//iterator
+
+					KERBAL_CONSTEXPR14
+					iterator begin() KERBAL_NOEXCEPT
+					{
+						return iterator(this->k_buffer);
+					}
+
+					KERBAL_CONSTEXPR14
+					iterator end() KERBAL_NOEXCEPT
+					{
+						return iterator(this->k_buffer + this->k_size);
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator begin() const KERBAL_NOEXCEPT
+					{
+						return const_iterator(this->k_buffer);
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator end() const KERBAL_NOEXCEPT
+					{
+						return const_iterator(this->k_buffer + this->k_size);
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator cbegin() const KERBAL_NOEXCEPT
+					{
+						return const_iterator(this->k_buffer);
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator cend() const KERBAL_NOEXCEPT
+					{
+						return const_iterator(this->k_buffer + this->k_size);
+					}
+
+					KERBAL_CONSTEXPR14
+					reverse_iterator rbegin() KERBAL_NOEXCEPT
+					{
+						return reverse_iterator(this->end());
+					}
+
+					KERBAL_CONSTEXPR14
+					reverse_iterator rend() KERBAL_NOEXCEPT
+					{
+						return reverse_iterator(this->begin());
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator rbegin() const KERBAL_NOEXCEPT
+					{
+						return const_reverse_iterator(this->end());
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator rend() const KERBAL_NOEXCEPT
+					{
+						return const_reverse_iterator(this->begin());
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator crbegin() const KERBAL_NOEXCEPT
+					{
+						return const_reverse_iterator(this->cend());
+					}
+
+					KERBAL_CONSTEXPR
+					const_reverse_iterator crend() const KERBAL_NOEXCEPT
+					{
+						return const_reverse_iterator(this->cbegin());
+					}
+
+					KERBAL_CONSTEXPR14
+					iterator nth(size_type index) KERBAL_NOEXCEPT
+					{
+						return this->begin() + index;
+					}
+
+					KERBAL_CONSTEXPR
+					const_iterator nth(size_type index) const KERBAL_NOEXCEPT
+					{
+						return this->cbegin() + index;
+					}
+
+					KERBAL_CONSTEXPR14
+					size_type index_of(iterator it) KERBAL_NOEXCEPT
+					{
+						return it - this->begin();
+					}
+
+					KERBAL_CONSTEXPR
+					size_type index_of(const_iterator it) const KERBAL_NOEXCEPT
+					{
+						return it - this->cbegin();
+					}
+
+				//===================
+				//capacity
+
+					KERBAL_CONSTEXPR
+					bool empty() const KERBAL_NOEXCEPT
+					{
+						return this->k_size == 0;
+					}
+
+					KERBAL_CONSTEXPR
+					size_type size() const KERBAL_NOEXCEPT
+					{
+						return this->k_size;
+					}
+
+					KERBAL_CONSTEXPR
+					size_type capacity() const KERBAL_NOEXCEPT
+					{
+						return this->k_capacity;
+					}
+
+				//===================
+				//private
+
+					KERBAL_CONSTEXPR14
+					void __swap_type_unrelated(vector_allocator_unrelated & ano) KERBAL_NOEXCEPT
+					{
+						kerbal::algorithm::swap(this->k_buffer, ano.k_buffer);
+						kerbal::algorithm::swap(this->k_size, ano.k_size);
+						kerbal::algorithm::swap(this->k_capacity, ano.k_capacity);
+					}
+
+			};
+
+			template <typename Tp, typename Allocator, bool allocator_can_be_empty_base =
+								kerbal::type_traits::can_be_empty_base<Allocator>::value >
+			class vector_allocator_overload;
+
+			template <typename Tp, typename Allocator>
+			class vector_allocator_overload<Tp, Allocator, false>
+			{
+				protected:
+					typedef Allocator		allocator_type;
+
+				protected:
+					allocator_type allocator;
+
+					KERBAL_CONSTEXPR
+					vector_allocator_overload()
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										std::is_nothrow_default_constructible<allocator_type>::value
+								)
+							: allocator()
+					{
+					}
+
+					KERBAL_CONSTEXPR
+					explicit vector_allocator_overload(const Allocator & allocator)
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										(std::is_nothrow_copy_constructible<allocator_type>::value)
+								)
+							: allocator(allocator)
+					{
+					}
+
+#			if __cplusplus >= 201103L
+
+					KERBAL_CONSTEXPR
+					explicit vector_allocator_overload(Allocator && allocator)
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										(std::is_nothrow_move_constructible<allocator_type>::value)
+								)
+							: allocator(kerbal::compatibility::move(allocator))
+					{
+					}
+
+#			endif
+
+					KERBAL_CONSTEXPR14
+					allocator_type& alloc() KERBAL_NOEXCEPT
+					{
+						return this->allocator;
+					}
+
+					KERBAL_CONSTEXPR14
+					const allocator_type& alloc() const KERBAL_NOEXCEPT
+					{
+						return this->allocator;
+					}
+
+			};
+
+			template <typename Tp, typename Allocator>
+			class vector_allocator_overload<Tp, Allocator, true>:
+					private kerbal::type_traits::remove_cv<Allocator>::type
+			{
+				private:
+					typedef typename kerbal::type_traits::remove_cv<Allocator>::type super;
+
+				protected:
+					typedef Allocator		allocator_type;
+
+				protected:
+
+					KERBAL_CONSTEXPR
+					vector_allocator_overload()
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										std::is_nothrow_default_constructible<super>::value
+								)
+							: super()
+					{
+					}
+
+					KERBAL_CONSTEXPR
+					explicit vector_allocator_overload(const Allocator & allocator)
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										(std::is_nothrow_constructible<super, const Allocator&>::value)
+								)
+							: super(allocator)
+					{
+					}
+
+#			if __cplusplus >= 201103L
+
+					KERBAL_CONSTEXPR
+					explicit vector_allocator_overload(Allocator && allocator)
+								KERBAL_CONDITIONAL_NOEXCEPT(
+										(std::is_nothrow_constructible<super, Allocator&&>::value)
+								)
+							: super(kerbal::compatibility::move(allocator))
+					{
+					}
+
+#			endif
+
+					KERBAL_CONSTEXPR14
+					allocator_type& alloc() KERBAL_NOEXCEPT
+					{
+						return static_cast<super&>(*this);
+					}
+
+					KERBAL_CONSTEXPR14
+					const allocator_type& alloc() const KERBAL_NOEXCEPT
+					{
+						return static_cast<const super&>(*this);
+					}
+
+			};
+
+
+			/*
+			 * The elements are stored here until they outnumber N, so that no allocation happens for the small ones.
+			 */
+			template <typename Tp, std::size_t N>
+			class vector_inline_storage
+			{
+				protected:
+					typedef kerbal::data_struct::raw_storage<Tp>				storage_type;
+
+				protected:
+					storage_type k_inline[N];
+
+					KERBAL_CONSTEXPR14
+					storage_type * __inline_buffer() KERBAL_NOEXCEPT
+					{
+						return this->k_inline;
+					}
+
+					KERBAL_CONSTEXPR
+					const storage_type * __inline_buffer() const KERBAL_NOEXCEPT
+					{
+						return this->k_inline;
+					}
+
+			};
+
+			template <typename Tp>
+			class vector_inline_storage<Tp, 0>
+			{
+				protected:
+					typedef kerbal::data_struct::raw_storage<Tp>				storage_type;
+
+				protected:
+					static
+					KERBAL_CONSTEXPR
+					storage_type * __inline_buffer() KERBAL_NOEXCEPT
+					{
+						return NULL;
+					}
+
+			};
+
+			/*
+			 * The implementation shared by vector (N == 0) and small_vector. The storage in use is either the inline
+			 * storage or the one got from the allocator, k_buffer always points to the inline one after released.
+			 */
+			template <typename Tp, typename Allocator, std::size_t N>
+			class vector_base:
+					protected kerbal::container::detail::vector_allocator_unrelated<Tp>,
+					protected kerbal::container::detail::vector_allocator_overload<Tp, Allocator>,
+					protected kerbal::container::detail::vector_inline_storage<Tp, N>
+			{
+				private:
+					typedef kerbal::container::detail::vector_allocator_unrelated<Tp>				vector_allocator_unrelated;
+					typedef kerbal::container::detail::vector_allocator_overload<Tp, Allocator>		vector_allocator_overload;
+					typedef kerbal::container::detail::vector_inline_storage<Tp, N>					vector_inline_storage;
+
+				public:
+					typedef typename vector_allocator_unrelated::value_type					value_type;
+					typedef typename vector_allocator_unrelated::const_type					const_type;
+					typedef typename vector_allocator_unrelated::reference					reference;
+					typedef typename vector_allocator_unrelated::const_reference			const_reference;
+					typedef typename vector_allocator_unrelated::pointer					pointer;
+					typedef typename vector_allocator_unrelated::const_pointer				const_pointer;
+
+#		if __cplusplus >= 201103L
+					typedef typename vector_allocator_unrelated::rvalue_reference			rvalue_reference;
+					typedef typename vector_allocator_unrelated::const_rvalue_reference		const_rvalue_reference;
+#		endif
+
+					typedef typename vector_allocator_unrelated::size_type					size_type;
+					typedef typename vector_allocator_unrelated::difference_type			difference_type;
+
+					typedef typename vector_allocator_unrelated::iterator					iterator;
+					typedef typename vector_allocator_unrelated::const_iterator				const_iterator;
+					typedef typename vector_allocator_unrelated::reverse_iterator			reverse_iterator;
+					typedef typename vector_allocator_unrelated::const_reverse_iterator		const_reverse_iterator;
+
+					typedef Allocator														allocator_type;
+
+				private:
+					typedef typename vector_allocator_unrelated::storage_type				storage_type;
+					typedef kerbal::memory::allocator_traits<allocator_type>				tp_allocator_traits;
+					typedef kerbal::type_traits::is_trivially_relocatable<Tp>				relocate_by_memcpy;
+
+					using vector_allocator_overload::alloc;
+					using vector_inline_storage::__inline_buffer;
+
+				protected:
+					vector_base();
+
+					explicit vector_base(const Allocator& alloc);
+
+					vector_base(const vector_base & src);
+
+					vector_base(const vector_base & src, const Allocator& alloc);
+
+					explicit vector_base(size_type n);
+
+					vector_base(size_type n, const Allocator& alloc);
+
+					vector_base(size_type n, const_reference val);
+
+					vector_base(size_type n, const_reference val, const Allocator& alloc);
+
+					template <typename InputIterator>
+					vector_base(InputIterator first, InputIterator last,
+							typename kerbal::type_traits::enable_if<
+									kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+									, int
+							>::type = 0
+					);
+
+					template <typename InputIterator>
+					vector_base(InputIterator first, InputIterator last, const Allocator& alloc,
+							typename kerbal::type_traits::enable_if<
+									kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+									, int
+							>::type = 0
+					);
+
+#		if __cplusplus >= 201103L
+
+					vector_base(vector_base && src)
+							KERBAL_CONDITIONAL_NOEXCEPT(
+									N == 0 || std::is_nothrow_move_constructible<Tp>::value
+							);
+
+					vector_base(vector_base && src, const Allocator& alloc);
+
+					vector_base(std::initializer_list<value_type> src);
+
+					vector_base(std::initializer_list<value_type> src, const Allocator& alloc);
+
+#		else
+
+					template <typename Up>
+					vector_base(const kerbal::assign::assign_list<Up> & src);
+
+					template <typename Up>
+					vector_base(const kerbal::assign::assign_list<Up> & src, const Allocator& alloc);
+
+#		endif
+
+					~vector_base() KERBAL_NOEXCEPT;
+
+				//===================
+				//assign
+
+					vector_base& operator=(const vector_base & src);
+
+#		if __cplusplus >= 201103L
+
+					vector_base& operator=(vector_base && src);
+
+					vector_base& operator=(std::initializer_list<value_type> src);
+
+#		else
+
+					template <typename Up>
+					vector_base& operator=(const kerbal::assign::assign_list<Up> & src);
+
+#		endif
+
+				public:
+					void assign(const vector_base & src);
+
+					void assign(size_type count, const_reference val);
+
+					template <typename InputIterator>
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+					>::type
+					assign(InputIterator first, InputIterator last);
+
+#		if __cplusplus >= 201103L
+
+					void assign(vector_base && src);
+
+					void assign(std::initializer_list<value_type> src);
+
+#		else
+
+					template <typename Up>
+					void assign(const kerbal::assign::assign_list<Up> & src);
+
+#		endif
+
+					allocator_type get_allocator() const;
+
+				//===================
+				//element access
+
+					using vector_allocator_unrelated::operator[];
+
+					reference at(size_type index);
+
+					const_reference at(size_type index) const;
+
+					using vector_allocator_unrelated::front;
+					using vector_allocator_unrelated::back;
+					using vector_allocator_unrelated::data;
+
+				//===================
+				//iterator
+
+					using vector_allocator_unrelated::begin;
+					using vector_allocator_unrelated::end;
+
+					using vector_allocator_unrelated::cbegin;
+					using vector_allocator_unrelated::cend;
+
+					using vector_allocator_unrelated::rbegin;
+					using vector_allocator_unrelated::rend;
+
+					using vector_allocator_unrelated::crbegin;
+					using vector_allocator_unrelated::crend;
+
+					using vector_allocator_unrelated::nth;
+					using vector_allocator_unrelated::index_of;
+
+				//===================
+				//capacity
+
+					using vector_allocator_unrelated::empty;
+					using vector_allocator_unrelated::size;
+					using vector_allocator_unrelated::capacity;
+
+					size_type max_size() const KERBAL_NOEXCEPT;
+
+					/**
+					 * @brief Make the capacity not less than new_cap, the iterators are invalidated if the storage is reallocated.
+					 */
+					void reserve(size_type new_cap);
+
+					/**
+					 * @brief Make the capacity equal to the size, the iterators are invalidated if the storage is reallocated.
+					 */
+					void shrink_to_fit();
+
+				//===================
+				//insert
+
+					void push_back(const_reference val);
+
+#		if __cplusplus >= 201103L
+
+					void push_back(rvalue_reference val);
+
+					template <typename ... Args>
+					reference emplace_back(Args&& ... args);
+
+#		else
+
+					reference emplace_back();
+
+					template <typename Arg0>
+					reference emplace_back(const Arg0& arg0);
+
+					template <typename Arg0, typename Arg1>
+					reference emplace_back(const Arg0& arg0, const Arg1& arg1);
+
+					template <typename Arg0, typename Arg1, typename Arg2>
+					reference emplace_back(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2);
+
+#		endif
+
+					iterator insert(const_iterator pos, const_reference val);
+
+					iterator insert(const_iterator pos, size_type n, const_reference val);
+
+					template <typename InputIterator>
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+							iterator
+					>::type
+					insert(const_iterator pos, InputIterator first, InputIterator last);
+
+#		if __cplusplus >= 201103L
+
+					iterator insert(const_iterator pos, rvalue_reference val);
+
+					iterator insert(const_iterator pos, std::initializer_list<value_type> src);
+
+					template <typename ... Args>
+					iterator emplace(const_iterator pos, Args&& ... args);
+
+#		else
+
+					template <typename Up>
+					iterator insert(const_iterator pos, const kerbal::assign::assign_list<Up> & src);
+
+					iterator emplace(const_iterator pos);
+
+					template <typename Arg0>
+					iterator emplace(const_iterator pos, const Arg0& arg0);
+
+					template <typename Arg0, typename Arg1>
+					iterator emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1);
+
+					template <typename Arg0, typename Arg1, typename Arg2>
+					iterator emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2);
+
+#		endif
+
+				//===================
+				//erase
+
+					void pop_back() KERBAL_NOEXCEPT;
+
+					iterator erase(const_iterator pos);
+
+					iterator erase(const_iterator first, const_iterator last);
+
+					void clear() KERBAL_NOEXCEPT;
+
+				//===================
+				//operation
+
+					void resize(size_type count);
+
+					void resize(size_type count, const_reference value);
+
+					void swap(vector_base & ano);
+
+				//===================
+				//private
+
+				private:
+
+					storage_type * __allocate(size_type n);
+
+					void __deallocate(storage_type * p, size_type n) KERBAL_NOEXCEPT;
+
+#		if __cplusplus >= 201103L
+
+					template <typename ... Args>
+					void __construct_at(storage_type * p, Args&& ... args);
+
+#		else
+
+					void __construct_at(storage_type * p);
+
+					template <typename Arg0>
+					void __construct_at(storage_type * p, const Arg0& arg0);
+
+					template <typename Arg0, typename Arg1>
+					void __construct_at(storage_type * p, const Arg0& arg0, const Arg1& arg1);
+
+					template <typename Arg0, typename Arg1, typename Arg2>
+					void __construct_at(storage_type * p, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2);
+
+#		endif
+
+					void __destroy(storage_type * first, storage_type * last) KERBAL_NOEXCEPT;
+
+					void __reset_to_inline() KERBAL_NOEXCEPT;
+
+					bool __is_inline() const KERBAL_NOEXCEPT;
+
+					/*
+					 * destroy all the elements and give the storage back to the allocator
+					 */
+					void __release() KERBAL_NOEXCEPT;
+
+					/*
+					 * release the current storage and take new_buffer, which holds new_size elements, as own
+					 */
+					void __adopt(storage_type * new_buffer, size_type new_size, size_type new_capacity) KERBAL_NOEXCEPT;
+
+					// pre-cond: this is empty and owns no allocated storage, src is not inline
+					void __steal(vector_base & src) KERBAL_NOEXCEPT;
+
+					// pre-cond: this is empty and owns no allocated storage
+					void __transfer_construct(vector_base & src);
+
+					/*
+					 * the capacity after growing to hold new_size elements
+					 */
+					size_type __recommend_capacity(size_type new_size) const;
+
+					/*
+					 * Construct the elements in [first, last) at `to`, by memcpy or by moving (only if nothrow).
+					 * The elements constructed are destroyed if any exception is thrown.
+					 */
+					storage_type * __uninitialized_transfer(storage_type * first, storage_type * last, storage_type * to,
+															kerbal::type_traits::false_type);
+
+					storage_type * __uninitialized_transfer(storage_type * first, storage_type * last, storage_type * to,
+															kerbal::type_traits::true_type) KERBAL_NOEXCEPT;
+
+					void __destroy_transferred(storage_type * first, storage_type * last,
+															kerbal::type_traits::false_type) KERBAL_NOEXCEPT;
+
+					void __destroy_transferred(storage_type * first, storage_type * last,
+															kerbal::type_traits::true_type) KERBAL_NOEXCEPT;
+
+					/*
+					 * Move the bytes of the elements in [first, last) to `to` by memmove, the ranges may overlap.
+					 * pre-cond: relocate_by_memcpy, the elements left in [first, last) are treated as uninitialized
+					 */
+					static void __relocate(storage_type * first, storage_type * last, storage_type * to) KERBAL_NOEXCEPT;
+
+					/*
+					 * Construct the elements at the uninitialized storage.
+					 * The elements constructed are destroyed if any exception is thrown.
+					 */
+					void __uninitialized_fill_n(storage_type * first, size_type n, const_reference val);
+
+					template <typename ForwardIterator>
+					void __uninitialized_copy(ForwardIterator first, ForwardIterator last, storage_type * to);
+
+					/*
+					 * Transfer the elements before idx to [new_buffer, new_buffer + idx) and the elements after idx to
+					 * [new_buffer + idx + n, ...), then take the new buffer as own. The gap has been constructed by the caller
+					 * and would be destroyed together with the new buffer if any exception is thrown.
+					 */
+					void __rebuild_around(storage_type * new_buffer, size_type new_cap, size_type idx, size_type n);
+
+					void __reallocate(size_type new_cap);
+
+#		if __cplusplus >= 201103L
+
+					template <typename ... Args>
+					void __emplace_realloc(size_type idx, Args&& ... args);
+
+#		else
+
+					void __emplace_realloc(size_type idx, const_reference val);
+
+#		endif
+
+					void __fill_construct(size_type n);
+
+					void __fill_construct(size_type n, const_reference val);
+
+					template <typename InputIterator>
+					void __range_construct(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+					template <typename ForwardIterator>
+					void __range_construct(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+					template <typename InputIterator>
+					void __range_assign(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+					template <typename ForwardIterator>
+					void __range_assign(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+					template <typename InputIterator>
+					iterator __range_insert(const_iterator pos, InputIterator first, InputIterator last, std::input_iterator_tag);
+
+					template <typename ForwardIterator>
+					iterator __range_insert(const_iterator pos, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+#		if __cplusplus >= 201103L
+
+					template <bool propagate_on_container_move_assignment>
+					typename kerbal::type_traits::enable_if<!propagate_on_container_move_assignment>::type
+					__move_assign_helper(vector_base && src);
+
+					template <bool propagate_on_container_move_assignment>
+					typename kerbal::type_traits::enable_if<propagate_on_container_move_assignment>::type
+					__move_assign_helper(vector_base && src);
+
+					void __move_assign_elements(vector_base & src);
+
+#		endif
+
+					template <bool propagate_on_container_swap>
+					typename kerbal::type_traits::enable_if<!propagate_on_container_swap>::type
+					__swap_allocator_helper(vector_base & /*ano*/)
+					{
+					}
+
+					template <bool propagate_on_container_swap>
+					typename kerbal::type_traits::enable_if<propagate_on_container_swap>::type
+					__swap_allocator_helper(vector_base & ano)
+					{
+						kerbal::algorithm::swap(this->alloc(), ano.alloc());
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#include <kerbal/container/impl/vector_base.impl.hpp>
+
+#endif // KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
@@ -13,10 +13,11 @@
 #define KERBAL_CONTAINER_FLAT_ORDERED_HPP
 
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/container/vector.hpp>
 #include <kerbal/container/detail/flat_ordered_base.hpp>
 
 #include <cstddef>
-#include <vector>
+#include <memory>
 
 namespace kerbal
 {
@@ -25,15 +26,13 @@ namespace kerbal
 	{
 
 		template <typename Entity, typename Key = Entity, typename KeyCompare = std::less<Key>,
-				typename Extract = default_extract<Key, Entity>, typename Allocator = std::allocator<Entity> >
+				typename Extract = default_extract<Key, Entity>, typename Allocator = std::allocator<Entity>,
+				typename Sequence = kerbal::container::vector<Entity, Allocator> >
 		class flat_ordered:
 				public kerbal::container::detail::flat_ordered_base<
-						Entity, Key, KeyCompare, Extract, std::vector<Entity, Allocator>
+						Entity, Key, KeyCompare, Extract, Sequence
 				>
 		{
-			public:
-				typedef std::vector<Entity, Allocator> Sequence;
-
 			private:
 				typedef kerbal::container::detail::flat_ordered_base<
 										Entity, Key, KeyCompare, Extract, Sequence
@@ -142,44 +141,44 @@ namespace kerbal
 					kerbal::algorithm::swap(this->key_comp_obj(), ano.key_comp_obj());
 				}
 
-				template <typename Allocator2>
-				friend bool operator==(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator==(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence == rhs.sequence;
 				}
 
-				template <typename Allocator2>
-				friend bool operator!=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator!=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence != rhs.sequence;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence < rhs.sequence;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence <= rhs.sequence;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence > rhs.sequence;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator> & lhs,
-										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>=(const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator, Sequence> & lhs,
+										const flat_ordered<Entity, Key, KeyCompare, Extract, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.sequence >= rhs.sequence;
 				}
@@ -21,12 +21,13 @@ namespace kerbal
 	namespace container
 	{
 
-		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp> >
+		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp>,
+				typename Sequence = kerbal::container::vector<Tp, Allocator> >
 		class flat_set
-				: public kerbal::container::detail::flat_set_base<Tp, kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator> >
+				: public kerbal::container::detail::flat_set_base<Tp, kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator, Sequence> >
 		{
 			private:
-				typedef kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator> Ordered;
+				typedef kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator, Sequence> Ordered;
 				typedef kerbal::container::detail::flat_set_base<Tp, Ordered> super;
 
 			public:
@@ -129,56 +130,57 @@ namespace kerbal
 					this->ordered.swap(ano.ordered);
 				}
 
-				template <typename Allocator2>
-				friend bool operator==(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator==(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered == rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator!=(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator!=(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered != rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered < rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<=(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<=(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered <= rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered > rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>=(const flat_set<Tp, KeyCompare, Allocator> & lhs,
-										const flat_set<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>=(const flat_set<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_set<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered >= rhs.ordered;
 				}
 
 		};
 
-		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp> >
+		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp>,
+				typename Sequence = kerbal::container::vector<Tp, Allocator> >
 		class flat_multiset
-				: public kerbal::container::detail::flat_multiset_base<Tp, kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator> >
+				: public kerbal::container::detail::flat_multiset_base<Tp, kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator, Sequence> >
 		{
 			private:
-				typedef kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator> Ordered;
+				typedef kerbal::container::flat_ordered<Tp, Tp, KeyCompare, default_extract<Tp, Tp>, Allocator, Sequence> Ordered;
 				typedef kerbal::container::detail::flat_multiset_base<Tp, Ordered> super;
 
 			public:
@@ -279,44 +281,44 @@ namespace kerbal
 					this->ordered.swap(ano.ordered);
 				}
 
-				template <typename Allocator2>
-				friend bool operator==(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator==(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered == rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator!=(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator!=(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered != rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered < rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator<=(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator<=(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered <= rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered > rhs.ordered;
 				}
 
-				template <typename Allocator2>
-				friend bool operator>=(const flat_multiset<Tp, KeyCompare, Allocator> & lhs,
-										const flat_multiset<Tp, KeyCompare, Allocator2> & rhs)
+				template <typename Allocator2, typename Sequence2>
+				friend bool operator>=(const flat_multiset<Tp, KeyCompare, Allocator, Sequence> & lhs,
+										const flat_multiset<Tp, KeyCompare, Allocator2, Sequence2> & rhs)
 				{
 					return lhs.ordered >= rhs.ordered;
 				}
@@ -753,7 +753,7 @@ namespace kerbal
 		void list<Tp, Allocator>::swap(list& ano)
 		{
 			typedef typename node_allocator_traits::propagate_on_container_swap propagate_on_container_swap;
-			this->swap_allocator_helper<propagate_on_container_swap::value>();
+			this->swap_allocator_helper<propagate_on_container_swap::value>(ano);
 
 			list_type_unrelated::__swap_type_unrelated(*this, ano);
 		}
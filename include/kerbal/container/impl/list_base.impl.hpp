@@ -17,6 +17,8 @@
 #include <kerbal/algorithm/swap.hpp>
 #include <kerbal/iterator/iterator.hpp>
 
+#include <climits>
+
 namespace kerbal
 {
 
@@ -230,6 +232,25 @@ namespace kerbal
 				}
 			}
 
+			/*
+			 * Put the NULL terminated chain start back between pre and post, and restore all the prev pointers.
+			 */
+			KERBAL_CONSTEXPR20
+			inline
+			void list_type_unrelated::__merge_sort_relink(node_base * pre, node_base * start, node_base * post) KERBAL_NOEXCEPT
+			{
+				node_base * prev = pre;
+				node_base * current = start;
+				while (current != NULL) {
+					current->prev = prev;
+					prev->next = current;
+					prev = current;
+					current = current->next;
+				}
+				prev->next = post;
+				post->prev = prev;
+			}
+
 
 
 			//===================
@@ -551,90 +572,150 @@ namespace kerbal
 				this->merge(other, std::less<value_type>());
 			}
 
+			/*
+			 * Merge the NULL terminated runs a and b, a is the result.
+			 * The prev pointers are kept along, except that the prev pointer of the head of a run points to its back.
+			 * Nodes in a go first among the equivalent ones.
+			 * If cmp throws, a is still a chain of all nodes of a and b by the next pointers, in unspecified order.
+			 */
 			template <typename Tp>
 			template <typename BinaryPredict>
 			KERBAL_CONSTEXPR20
-			void list_allocator_unrelated<Tp>::merge_sort_merge(iterator first, iterator mid, iterator last, BinaryPredict cmp)
+			void list_allocator_unrelated<Tp>::merge_sort_merge(node_base * & a, node_base * b, BinaryPredict & cmp)
 			{
-				node * a = static_cast<node*>(first.current);
-				node_base * const a_back = mid.current->prev;
-
-				a_back->next = NULL;
-
-				mid.current->prev = a->prev;
-				a->prev->next = mid.current;
-
-				while (a != NULL) {
-					if (mid != last) {
+				node_base * const a_back = a->prev;
+				node_base * const b_back = b->prev;
+				node_base * head = NULL;
+				node_base * * tail = &head;
+				node_base * prev = NULL;
+				node_base * pa = a;
+				while (pa != NULL && b != NULL) {
 
 #			if __cpp_exceptions
-						bool flag = false;
-						try {
-							flag = static_cast<bool>(cmp(*mid, a->value));
-						} catch (...) {
-							__hook_node(mid, a, a_back);
-							throw;
+					bool flag = false;
+					try {
+						flag = static_cast<bool>(cmp(static_cast<node*>(b)->value, static_cast<node*>(pa)->value));
+					} catch (...) {
+						*tail = pa;
+						while (*tail != NULL) {
+							tail = &(*tail)->next;
 						}
+						*tail = b;
+						a = head;
+						throw;
+					}
 #			else
-						bool flag = static_cast<bool>(cmp(*mid, a->value));
+					bool flag = static_cast<bool>(cmp(static_cast<node*>(b)->value, static_cast<node*>(pa)->value));
 #			endif // __cpp_exceptions
 
-
-						if (flag) {
-							++mid;
-						} else {
-							node_base * t = a->next;
-							__hook_node(mid, a);
-							a = static_cast<node*>(t);
-						}
+					if (flag) {
+						*tail = b;
+						b->prev = prev;
+						prev = b;
+						tail = &b->next;
+						b = b->next;
 					} else {
-						__hook_node(mid, a, a_back);
-						return;
+						*tail = pa;
+						pa->prev = prev;
+						prev = pa;
+						tail = &pa->next;
+						pa = pa->next;
 					}
 				}
+				if (pa != NULL) {
+					*tail = pa;
+					pa->prev = prev;
+					head->prev = a_back;
+				} else {
+					*tail = b;
+					b->prev = prev;
+					head->prev = b_back;
+				}
+				a = head;
 			}
 
+			/*
+			 * Bottom-up merge sort by splicing the nodes. bins[i] is either empty or a sorted run of 2^i nodes,
+			 * every node taken from the range is merged into them like a carry in binary addition.
+			 * No distance computation and no recursion are needed. Stable.
+			 */
 			template <typename Tp>
 			template <typename BinaryPredict>
 			KERBAL_CONSTEXPR20
-			typename list_allocator_unrelated<Tp>::iterator
-			list_allocator_unrelated<Tp>::merge_sort_n(iterator first, difference_type len, BinaryPredict cmp)
+			void list_allocator_unrelated<Tp>::sort(iterator first, iterator last, BinaryPredict cmp)
 			{
-				if (len == 0) {
-					return first;
-				}
-				if (len == 1) {
-					return kerbal::iterator::next(first);
-				}
-				if (len == 2) {
-					iterator i(kerbal::iterator::next(first));
-					iterator r(kerbal::iterator::next(i));
-					if (cmp(*i, *first)) {
-						this->iter_swap(first, i);
-					}
-					return r;
+				if (first == last) {
+					return;
 				}
-				difference_type first_half_len = len / 2;
 
-				iterator pre_first(kerbal::iterator::prev(first));
-				iterator mid(this->merge_sort_n(first, first_half_len, cmp));
+				node_base * const pre = first.current->prev;
+				node_base * const post = last.current;
+				post->prev->next = NULL;
 
-				iterator pre_mid(kerbal::iterator::prev(mid));
-				iterator last(this->merge_sort_n(mid, len - first_half_len, cmp));
+				node_base * bins[sizeof(size_type) * CHAR_BIT] = {NULL};
+				size_type fill = 0;
+				node_base * carry = NULL;
+				node_base * remain = first.current;
 
-				first = kerbal::iterator::next(pre_first);
-				mid = kerbal::iterator::next(pre_mid);
-				this->merge_sort_merge(first, mid, last, cmp);
+#			if __cpp_exceptions
+				try {
+#			endif // __cpp_exceptions
 
-				return last;
-			}
+					while (remain != NULL) {
+						carry = remain;
+						remain = remain->next;
+						carry->next = NULL;
+						carry->prev = carry;
+						size_type i = 0;
+						while (i < fill && bins[i] != NULL) {
+							node_base * t = carry;
+							carry = NULL;
+							merge_sort_merge(bins[i], t, cmp); // the older run goes first
+							carry = bins[i];
+							bins[i] = NULL;
+							++i;
+						}
+						bins[i] = carry;
+						carry = NULL;
+						if (i == fill) {
+							++fill;
+						}
+					}
 
-			template <typename Tp>
-			template <typename BinaryPredict>
-			KERBAL_CONSTEXPR20
-			void list_allocator_unrelated<Tp>::sort(iterator first, iterator last, BinaryPredict cmp)
-			{
-				this->merge_sort_n(first, kerbal::iterator::distance(first, last), cmp);
+					for (size_type i = 0; i < fill; ++i) {
+						if (bins[i] == NULL) {
+							continue;
+						}
+						if (carry != NULL) {
+							node_base * t = carry;
+							carry = NULL;
+							merge_sort_merge(bins[i], t, cmp);
+						}
+						carry = bins[i];
+						bins[i] = NULL;
+					}
+
+#			if __cpp_exceptions
+				} catch (...) {
+					// put all the nodes back to the list, in unspecified order
+					node_base * head = carry;
+					node_base * * tail = &head;
+					for (size_type i = 0; i <= fill; ++i) {
+						while (*tail != NULL) {
+							tail = &(*tail)->next;
+						}
+						*tail = i < fill ? bins[i] : remain;
+					}
+					__merge_sort_relink(pre, head, post);
+					throw;
+				}
+#			endif // __cpp_exceptions
+
+				node_base * const back = carry->prev;
+				carry->prev = pre;
+				pre->next = carry;
+				back->next = post;
+				post->prev = back;
 			}
 
 			template <typename Tp>
@@ -748,7 +748,7 @@ namespace kerbal
 		void single_list<Tp, Allocator>::swap(single_list & ano)
 		{
 			typedef typename node_allocator_traits::propagate_on_container_swap propagate_on_container_swap;
-			this->swap_allocator_helper<propagate_on_container_swap::value>();
+			this->swap_allocator_helper<propagate_on_container_swap::value>(ano);
 
 			sl_allocator_unrelated::swap_allocator_unrelated(ano);
 		}
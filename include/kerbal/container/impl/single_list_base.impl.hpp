@@ -17,6 +17,9 @@
 #include <kerbal/algorithm/swap.hpp>
 #include <kerbal/iterator/iterator.hpp>
 
+#include <climits>
+#include <functional>
+
 namespace kerbal
 {
 
@@ -236,6 +239,27 @@ namespace kerbal
 				not_empty_list.last_iter = not_empty_list.basic_begin();
 			}
 
+			/*
+			 * Put the NULL terminated chain [start, back] back between pre and post, update last_iter if post is NULL.
+			 * back is searched from start if it is NULL.
+			 */
+			KERBAL_CONSTEXPR20
+			inline
+			void sl_type_unrelated::__merge_sort_relink(node_base * pre, node_base * start, node_base * back, node_base * post) KERBAL_NOEXCEPT
+			{
+				pre->next = start;
+				if (back == NULL) {
+					back = start;
+					while (back->next != NULL) {
+						back = back->next;
+					}
+				}
+				back->next = post;
+				if (post == NULL) {
+					this->last_iter = basic_iterator(back);
+				}
+			}
+
 
 
 			//===================
@@ -431,6 +455,165 @@ namespace kerbal
 				sl_type_unrelated::reverse();
 			}
 
+			/*
+			 * Merge the NULL terminated runs [a, a_back] and [b, b_back], [a, a_back] is the result.
+			 * Nodes in a go first among the equivalent ones.
+			 * If cmp throws, a is still a chain of all nodes of a and b, in unspecified order.
+			 */
+			template <typename Tp>
+			template <typename BinaryPredict>
+			KERBAL_CONSTEXPR20
+			void sl_allocator_unrelated<Tp>::merge_sort_merge(node_base * & a, node_base * & a_back,
+															node_base * b, node_base * b_back, BinaryPredict & cmp)
+			{
+				node_base * head = NULL;
+				node_base * * tail = &head;
+				node_base * pa = a;
+				while (pa != NULL && b != NULL) {
+
+#			if __cpp_exceptions
+					bool flag = false;
+					try {
+						flag = static_cast<bool>(cmp(static_cast<node*>(b)->value, static_cast<node*>(pa)->value));
+					} catch (...) {
+						*tail = pa;
+						while (*tail != NULL) {
+							tail = &(*tail)->next;
+						}
+						*tail = b;
+						a = head;
+						throw;
+					}
+#			else
+					bool flag = static_cast<bool>(cmp(static_cast<node*>(b)->value, static_cast<node*>(pa)->value));
+#			endif // __cpp_exceptions
+
+					if (flag) {
+						*tail = b;
+						tail = &b->next;
+						b = b->next;
+					} else {
+						*tail = pa;
+						tail = &pa->next;
+						pa = pa->next;
+					}
+				}
+				if (pa != NULL) {
+					*tail = pa;
+				} else {
+					*tail = b;
+					a_back = b_back;
+				}
+				a = head;
+			}
+
+			/*
+			 * Bottom-up merge sort by splicing the nodes. bins[i] is either empty or a sorted run of 2^i nodes,
+			 * every node taken from the range is merged into them like a carry in binary addition.
+			 * No distance computation and no recursion are needed. Stable.
+			 */
+			template <typename Tp>
+			template <typename BinaryPredict>
+			KERBAL_CONSTEXPR20
+			void sl_allocator_unrelated<Tp>::sort(iterator first, iterator last, BinaryPredict cmp)
+			{
+				if (first == last) {
+					return;
+				}
+
+				node_base * const pre = first.current;
+				node_base * const post = last.current->next;
+				last.current->next = NULL;
+
+				node_base * bins[sizeof(size_type) * CHAR_BIT] = {NULL};
+				node_base * bins_back[sizeof(size_type) * CHAR_BIT] = {NULL};
+				size_type fill = 0;
+				node_base * carry = NULL;
+				node_base * carry_back = NULL;
+				node_base * remain = pre->next;
+
+#			if __cpp_exceptions
+				try {
+#			endif // __cpp_exceptions
+
+					while (remain != NULL) {
+						carry = remain;
+						carry_back = remain;
+						remain = remain->next;
+						carry->next = NULL;
+						size_type i = 0;
+						while (i < fill && bins[i] != NULL) {
+							node_base * t = carry;
+							carry = NULL;
+							merge_sort_merge(bins[i], bins_back[i], t, carry_back, cmp); // the older run goes first
+							carry = bins[i];
+							carry_back = bins_back[i];
+							bins[i] = NULL;
+							++i;
+						}
+						bins[i] = carry;
+						bins_back[i] = carry_back;
+						carry = NULL;
+						if (i == fill) {
+							++fill;
+						}
+					}
+
+					for (size_type i = 0; i < fill; ++i) {
+						if (bins[i] == NULL) {
+							continue;
+						}
+						if (carry != NULL) {
+							node_base * t = carry;
+							carry = NULL;
+							merge_sort_merge(bins[i], bins_back[i], t, carry_back, cmp);
+						}
+						carry = bins[i];
+						carry_back = bins_back[i];
+						bins[i] = NULL;
+					}
+
+#			if __cpp_exceptions
+				} catch (...) {
+					// put all the nodes back to the list, in unspecified order
+					node_base * head = carry;
+					node_base * * tail = &head;
+					for (size_type i = 0; i <= fill; ++i) {
+						while (*tail != NULL) {
+							tail = &(*tail)->next;
+						}
+						*tail = i < fill ? bins[i] : remain;
+					}
+					this->__merge_sort_relink(pre, head, NULL, post);
+					throw;
+				}
+#			endif // __cpp_exceptions
+
+				this->__merge_sort_relink(pre, carry, carry_back, post);
+			}
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR20
+			void sl_allocator_unrelated<Tp>::sort(iterator first, iterator last)
+			{
+				this->sort(first, last, std::less<value_type>());
+			}
+
+			template <typename Tp>
+			template <typename BinaryPredict>
+			KERBAL_CONSTEXPR20
+			void sl_allocator_unrelated<Tp>::sort(BinaryPredict cmp)
+			{
+				this->sort(this->begin(), this->end(), cmp);
+			}
+
+			template <typename Tp>
+			KERBAL_CONSTEXPR20
+			void sl_allocator_unrelated<Tp>::sort()
+			{
+				this->sort(this->begin(), this->end());
+			}
+
 			template <typename Tp>
 			KERBAL_CONSTEXPR20
 			void sl_allocator_unrelated<Tp>::swap_allocator_unrelated(sl_allocator_unrelated & ano) KERBAL_NOEXCEPT
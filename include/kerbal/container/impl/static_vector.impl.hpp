@@ -14,14 +14,18 @@
 
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/operators/generic_assign.hpp>
 #include <kerbal/type_traits/can_be_pseudo_destructible.hpp>
 #include <kerbal/type_traits/enable_if.hpp>
 #include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_copyable.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
 #include <kerbal/utility/throw_this_exception.hpp>
 
+#include <cstring>
 #include <stdexcept>
 #include <utility> // std::forward
 
@@ -52,6 +56,11 @@ namespace kerbal
 		static_vector<Tp, N>::static_vector(const static_vector & src) :
 				super()
 		{
+			if (this->__memcpy_enabled()) {
+				this->__memcpy_from(src);
+				return;
+			}
+
 			// if any exception thrown, static_vector_base will do the cleanup job
 
 			const_iterator first = src.cbegin();
@@ -116,6 +125,12 @@ namespace kerbal
 		static_vector<Tp, N>::static_vector(static_vector && src) :
 				super()
 		{
+			if (this->__relocate_enabled()) {
+				this->__memcpy_from(src);
+				src.len = 0; // the elements go along with the bytes, don't destroy them
+				return;
+			}
+
 			// if any exception thrown, static_vector_base will do the cleanup job
 
 			const_iterator first = src.cbegin();
@@ -147,6 +162,7 @@ namespace kerbal
 
 #	undef EACH
 
+			src.clear();
 		}
 
 #	endif
@@ -244,6 +260,12 @@ namespace kerbal
 		KERBAL_CONSTEXPR14
 		static_vector<Tp, N>& static_vector<Tp, N>::operator=(const static_vector & src)
 		{
+			if (this->__memcpy_enabled()) {
+				if (this != &src) {
+					this->__memcpy_from(src);
+				}
+				return *this;
+			}
 			this->assign(src.cbegin(), src.cend());
 			return *this;
 		}
@@ -721,6 +743,12 @@ namespace kerbal
 		typename static_vector<Tp, N>::iterator
 		static_vector<Tp, N>::insert(const_iterator pos, const_reference val)
 		{
+			if (this->__relocate_enabled()) {
+				storage_type tmp;
+				tmp.construct(val); // val may be an element of this
+				return this->__relocate_insert(this->index_of(pos), tmp);
+			}
+
 			iterator mutable_pos(pos.cast_to_mutable());
 			if (pos == this->cend()) {
 				// if *this is empty, the only valid iterator pos is equal to cend()!
@@ -767,6 +795,12 @@ namespace kerbal
 		typename static_vector<Tp, N>::iterator
 		static_vector<Tp, N>::emplace(const const_iterator pos, Args&& ...args)
 		{
+			if (this->__relocate_enabled()) {
+				storage_type tmp;
+				tmp.construct(std::forward<Args>(args)...);
+				return this->__relocate_insert(this->index_of(pos), tmp);
+			}
+
 			iterator mutable_pos(pos.cast_to_mutable());
 			if (pos == this->cend()) {
 				// A A A O O O
@@ -788,6 +822,11 @@ namespace kerbal
 #	else
 
 #	define EMPLACE_BODY(args...) do { \
+			if (this->__relocate_enabled()) { \
+				storage_type tmp; \
+				tmp.construct(args); \
+				return this->__relocate_insert(this->index_of(pos), tmp); \
+			} \
 			iterator mutable_pos(pos.cast_to_mutable()); \
 			if (pos == this->cend()) { \
 				this->emplace_back(args); \
@@ -845,6 +884,11 @@ namespace kerbal
 				return mutable_pos;
 			}
 
+			if (this->__relocate_enabled()) {
+				size_type index = this->index_of(pos);
+				return this->__relocate_erase(index, index + 1);
+			}
+
 			// pre-condition: pos != cend()
 			kerbal::algorithm::move(mutable_pos + 1, this->end(), mutable_pos);
 			this->pop_back();
@@ -856,6 +900,10 @@ namespace kerbal
 		typename static_vector<Tp, N>::iterator
 		static_vector<Tp, N>::erase(const_iterator first, const_iterator last)
 		{
+			if (this->__relocate_enabled()) {
+				return this->__relocate_erase(this->index_of(first), this->index_of(last));
+			}
+
 			iterator mutable_first(first.cast_to_mutable());
 			iterator mutable_last(last.cast_to_mutable());
 
@@ -872,6 +920,7 @@ namespace kerbal
 		{
 			if (this->size() > with.size()) {
 				with.swap(*this);
+				return;
 			}
 
 			static_vector & s_arr = *this;
@@ -880,6 +929,15 @@ namespace kerbal
 			kerbal::algorithm::range_swap(s_arr.begin(), s_arr.end(), l_arr.begin());
 
 			size_type s_len = s_arr.size();
+
+			if (this->__relocate_enabled()) {
+				std::memcpy(static_cast<void*>(s_arr.storage + s_len), static_cast<const void*>(l_arr.storage + s_len),
+							(l_arr.len - s_len) * sizeof(storage_type));
+				s_arr.len = l_arr.len;
+				l_arr.len = s_len;
+				return;
+			}
+
 			const iterator l_end = l_arr.end();
 
 			for (iterator l_it = l_arr.nth(s_len); l_it != l_end; ++l_it) {
@@ -1008,6 +1066,54 @@ namespace kerbal
 			(itor.current)->destroy();
 		}
 
+		template <typename Tp, size_t N>
+		KERBAL_CONSTEXPR14
+		bool static_vector<Tp, N>::__memcpy_enabled() KERBAL_NOEXCEPT
+		{
+			return kerbal::type_traits::is_trivially_copyable<value_type>::value && !KERBAL_MAY_BE_CONSTANT_EVALUATED();
+		}
+
+		template <typename Tp, size_t N>
+		void static_vector<Tp, N>::__memcpy_from(const static_vector & src) KERBAL_NOEXCEPT
+		{
+			// the elements are trivially destructible, so the previous ones are just overwritten
+			std::memcpy(static_cast<void*>(this->storage), static_cast<const void*>(src.storage),
+						src.len * sizeof(storage_type));
+			this->len = src.len;
+		}
+
+		template <typename Tp, size_t N>
+		KERBAL_CONSTEXPR14
+		bool static_vector<Tp, N>::__relocate_enabled() KERBAL_NOEXCEPT
+		{
+			return kerbal::type_traits::is_trivially_relocatable<value_type>::value && !KERBAL_MAY_BE_CONSTANT_EVALUATED();
+		}
+
+		template <typename Tp, size_t N>
+		typename static_vector<Tp, N>::iterator
+		static_vector<Tp, N>::__relocate_insert(size_type index, storage_type & tmp) KERBAL_NOEXCEPT
+		{
+			storage_type * const pos = this->storage + index;
+			std::memmove(static_cast<void*>(pos + 1), static_cast<const void*>(pos),
+						(this->len - index) * sizeof(storage_type));
+			std::memcpy(static_cast<void*>(pos), static_cast<const void*>(&tmp), sizeof(storage_type));
+			++this->len;
+			return this->nth(index);
+		}
+
+		template <typename Tp, size_t N>
+		typename static_vector<Tp, N>::iterator
+		static_vector<Tp, N>::__relocate_erase(size_type first, size_type last) KERBAL_NOEXCEPT
+		{
+			for (size_type i = first; i != last; ++i) {
+				this->storage[i].destroy();
+			}
+			std::memmove(static_cast<void*>(this->storage + first), static_cast<const void*>(this->storage + last),
+						(this->len - last) * sizeof(storage_type));
+			this->len -= last - first;
+			return this->nth(first);
+		}
+
 	} // namespace container
 
 } // namespace kerbal
@@ -0,0 +1,1381 @@
+/**
+ * @file       vector_base.impl.hpp
+ * @brief
+ * @date       2020-09-07
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_IMPL_VECTOR_BASE_IMPL_HPP
+#define KERBAL_CONTAINER_IMPL_VECTOR_BASE_IMPL_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+
+#include <kerbal/container/detail/vector_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base()
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(const vector_base & src)
+					: vector_allocator_unrelated(), vector_allocator_overload(src.alloc()), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.cbegin(), src.cend(), std::random_access_iterator_tag());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(const vector_base & src, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.cbegin(), src.cend(), std::random_access_iterator_tag());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(size_type n)
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__fill_construct(n);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(size_type n, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__fill_construct(n);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(size_type n, const_reference val)
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__fill_construct(n, val);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(size_type n, const_reference val, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__fill_construct(n, val);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			vector_base<Tp, Allocator, N>::vector_base(InputIterator first, InputIterator last,
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+							, int
+					>::type)
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(first, last, kerbal::iterator::iterator_category(first));
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			vector_base<Tp, Allocator, N>::vector_base(InputIterator first, InputIterator last, const Allocator& alloc,
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+							, int
+					>::type)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(first, last, kerbal::iterator::iterator_category(first));
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(vector_base && src)
+						KERBAL_CONDITIONAL_NOEXCEPT(
+								N == 0 || std::is_nothrow_move_constructible<Tp>::value
+						)
+					: vector_allocator_unrelated(), vector_allocator_overload(kerbal::compatibility::move(src.alloc())), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				if (src.__is_inline()) {
+					this->__transfer_construct(src);
+				} else {
+					this->__steal(src);
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(vector_base && src, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				if (!src.__is_inline() && this->alloc() == src.alloc()) {
+					this->__steal(src);
+				} else {
+					this->__transfer_construct(src);
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(std::initializer_list<value_type> src)
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.begin(), src.end(), std::random_access_iterator_tag());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::vector_base(std::initializer_list<value_type> src, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.begin(), src.end(), std::random_access_iterator_tag());
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Up>
+			vector_base<Tp, Allocator, N>::vector_base(const kerbal::assign::assign_list<Up> & src)
+					: vector_allocator_unrelated(), vector_allocator_overload(), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.cbegin(), src.cend(), kerbal::iterator::iterator_category(src.cbegin()));
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Up>
+			vector_base<Tp, Allocator, N>::vector_base(const kerbal::assign::assign_list<Up> & src, const Allocator& alloc)
+					: vector_allocator_unrelated(), vector_allocator_overload(alloc), vector_inline_storage()
+			{
+				this->__reset_to_inline();
+				this->__range_construct(src.cbegin(), src.cend(), kerbal::iterator::iterator_category(src.cbegin()));
+			}
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>::~vector_base() KERBAL_NOEXCEPT
+			{
+				this->__release();
+			}
+
+			//===================
+			//assign
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>&
+			vector_base<Tp, Allocator, N>::operator=(const vector_base & src)
+			{
+				this->assign(src);
+				return *this;
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>&
+			vector_base<Tp, Allocator, N>::operator=(vector_base && src)
+			{
+				this->assign(kerbal::compatibility::move(src));
+				return *this;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			vector_base<Tp, Allocator, N>&
+			vector_base<Tp, Allocator, N>::operator=(std::initializer_list<value_type> src)
+			{
+				this->assign(src);
+				return *this;
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Up>
+			vector_base<Tp, Allocator, N>&
+			vector_base<Tp, Allocator, N>::operator=(const kerbal::assign::assign_list<Up> & src)
+			{
+				this->assign(src);
+				return *this;
+			}
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::assign(const vector_base & src)
+			{
+				if (this != &src) {
+					this->__range_assign(src.cbegin(), src.cend(), std::random_access_iterator_tag());
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::assign(size_type count, const_reference val)
+			{
+				if (count > this->k_capacity) {
+					storage_type * new_buffer = this->__allocate(count);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_fill_n(new_buffer, count, val);
+#		if __cpp_exceptions
+					} catch (...) {
+						this->__deallocate(new_buffer, count);
+						throw;
+					}
+#		endif
+					this->__adopt(new_buffer, count, count);
+				} else if (count > this->k_size) {
+					kerbal::algorithm::fill(this->begin(), this->end(), val);
+					while (this->k_size != count) {
+						this->__construct_at(this->k_buffer + this->k_size, val);
+						++this->k_size;
+					}
+				} else {
+					kerbal::algorithm::fill(this->begin(), this->nth(count), val);
+					this->__destroy(this->k_buffer + count, this->k_buffer + this->k_size);
+					this->k_size = count;
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			typename kerbal::type_traits::enable_if<
+					kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+			>::type
+			vector_base<Tp, Allocator, N>::assign(InputIterator first, InputIterator last)
+			{
+				this->__range_assign(first, last, kerbal::iterator::iterator_category(first));
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::assign(vector_base && src)
+			{
+				if (this != &src) {
+					this->__move_assign_helper<tp_allocator_traits::propagate_on_container_move_assignment::value>(
+							kerbal::compatibility::move(src));
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::assign(std::initializer_list<value_type> src)
+			{
+				this->__range_assign(src.begin(), src.end(), std::random_access_iterator_tag());
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Up>
+			void vector_base<Tp, Allocator, N>::assign(const kerbal::assign::assign_list<Up> & src)
+			{
+				this->assign(src.cbegin(), src.cend());
+			}
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::allocator_type
+			vector_base<Tp, Allocator, N>::get_allocator() const
+			{
+				return this->alloc();
+			}
+
+			//===================
+			//element access
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::at(size_type index)
+			{
+				if (index >= this->size()) {
+					kerbal::utility::throw_this_exception_helper<std::out_of_range>::throw_this_exception((const char*)"range check fail in vector");
+				}
+				return (*this)[index];
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::const_reference
+			vector_base<Tp, Allocator, N>::at(size_type index) const
+			{
+				if (index >= this->size()) {
+					kerbal::utility::throw_this_exception_helper<std::out_of_range>::throw_this_exception((const char*)"range check fail in vector");
+				}
+				return (*this)[index];
+			}
+
+			//===================
+			//capacity
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::size_type
+			vector_base<Tp, Allocator, N>::max_size() const KERBAL_NOEXCEPT
+			{
+				return static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(storage_type);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::reserve(size_type new_cap)
+			{
+				if (new_cap <= this->k_capacity) {
+					return;
+				}
+				if (new_cap > this->max_size()) {
+					kerbal::utility::throw_this_exception_helper<std::length_error>::throw_this_exception((const char*)"vector::reserve exceeds max_size");
+				}
+				this->__reallocate(new_cap);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::shrink_to_fit()
+			{
+				if (this->k_size == this->k_capacity || this->__is_inline()) {
+					return;
+				}
+				if (this->k_size <= N) { // move back to the inline buffer
+					this->__rebuild_around(this->__inline_buffer(), N, this->k_size, 0);
+					return;
+				}
+				this->__reallocate(this->k_size);
+			}
+
+			//===================
+			//insert
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::push_back(const_reference val)
+			{
+				this->emplace_back(val);
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::push_back(rvalue_reference val)
+			{
+				this->emplace_back(kerbal::compatibility::move(val));
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ... Args>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::emplace_back(Args&& ... args)
+			{
+				if (this->k_size == this->k_capacity) {
+					this->__emplace_realloc(this->k_size, std::forward<Args>(args)...);
+				} else {
+					this->__construct_at(this->k_buffer + this->k_size, std::forward<Args>(args)...);
+					++this->k_size;
+				}
+				return this->back();
+			}
+
+#	else
+
+#	define __emplace_back_body(args...) \
+			{ \
+				if (this->k_size == this->k_capacity) { \
+					value_type tmp(args); \
+					this->__emplace_realloc(this->k_size, tmp); \
+				} else { \
+					this->__construct_at(this->k_buffer + this->k_size, args); \
+					++this->k_size; \
+				} \
+				return this->back(); \
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::emplace_back()
+			{
+				if (this->k_size == this->k_capacity) {
+					this->__emplace_realloc(this->k_size, value_type());
+				} else {
+					this->__construct_at(this->k_buffer + this->k_size);
+					++this->k_size;
+				}
+				return this->back();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::emplace_back(const Arg0& arg0)
+			{
+				__emplace_back_body(arg0)
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::emplace_back(const Arg0& arg0, const Arg1& arg1)
+			{
+				__emplace_back_body(arg0, arg1)
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1, typename Arg2>
+			typename vector_base<Tp, Allocator, N>::reference
+			vector_base<Tp, Allocator, N>::emplace_back(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+			{
+				__emplace_back_body(arg0, arg1, arg2)
+			}
+
+#	undef __emplace_back_body
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, const_reference val)
+			{
+				return this->emplace(pos, val);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, size_type n, const_reference val)
+			{
+				size_type idx = this->index_of(pos);
+				if (n == 0) {
+					return this->nth(idx);
+				}
+				if (n > this->k_capacity - this->k_size) {
+					size_type new_cap = this->__recommend_capacity(n);
+					storage_type * new_buffer = this->__allocate(new_cap);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_fill_n(new_buffer + idx, n, val);
+#		if __cpp_exceptions
+					} catch (...) {
+						this->__deallocate(new_buffer, new_cap);
+						throw;
+					}
+#		endif
+					this->__rebuild_around(new_buffer, new_cap, idx, n);
+					return this->nth(idx);
+				}
+
+				value_type tmp(val); // val may be an element of this vector
+				const size_type old_size = this->k_size;
+				const size_type elems_after = old_size - idx;
+				if (relocate_by_memcpy::value) {
+					storage_type * const hole = this->k_buffer + idx;
+					__relocate(hole, hole + elems_after, hole + n);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_fill_n(hole, n, tmp);
+#		if __cpp_exceptions
+					} catch (...) {
+						__relocate(hole + n, hole + n + elems_after, hole);
+						throw;
+					}
+#		endif
+					this->k_size += n;
+				} else if (elems_after > n) {
+					for (size_type i = old_size - n; i != old_size; ++i) {
+						this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::to_xvalue(this->k_buffer[i].raw_value()));
+						++this->k_size;
+					}
+					kerbal::algorithm::move_backward(this->nth(idx), this->nth(old_size - n), this->nth(old_size));
+					kerbal::algorithm::fill(this->nth(idx), this->nth(idx + n), tmp);
+				} else {
+					for (size_type i = elems_after; i != n; ++i) {
+						this->__construct_at(this->k_buffer + this->k_size, tmp);
+						++this->k_size;
+					}
+					for (size_type i = idx; i != old_size; ++i) {
+						this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::to_xvalue(this->k_buffer[i].raw_value()));
+						++this->k_size;
+					}
+					kerbal::algorithm::fill(this->nth(idx), this->nth(old_size), tmp);
+				}
+				return this->nth(idx);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			typename kerbal::type_traits::enable_if<
+					kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+					typename vector_base<Tp, Allocator, N>::iterator
+			>::type
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, InputIterator first, InputIterator last)
+			{
+				return this->__range_insert(pos, first, last, kerbal::iterator::iterator_category(first));
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, rvalue_reference val)
+			{
+				return this->emplace(pos, kerbal::compatibility::move(val));
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, std::initializer_list<value_type> src)
+			{
+				return this->__range_insert(pos, src.begin(), src.end(), std::random_access_iterator_tag());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ... Args>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::emplace(const_iterator pos, Args&& ... args)
+			{
+				size_type idx = this->index_of(pos);
+				if (this->k_size == this->k_capacity) {
+					this->__emplace_realloc(idx, std::forward<Args>(args)...);
+				} else if (idx == this->k_size) {
+					this->__construct_at(this->k_buffer + this->k_size, std::forward<Args>(args)...);
+					++this->k_size;
+				} else if (relocate_by_memcpy::value) {
+					storage_type tmp;
+					this->__construct_at(&tmp, std::forward<Args>(args)...); // args may refer to the elements of this vector
+					storage_type * const hole = this->k_buffer + idx;
+					__relocate(hole, this->k_buffer + this->k_size, hole + 1);
+					__relocate(&tmp, &tmp + 1, hole);
+					++this->k_size;
+				} else {
+					value_type tmp(std::forward<Args>(args)...); // args may refer to the elements of this vector
+					this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::to_xvalue(this->back()));
+					++this->k_size;
+					kerbal::algorithm::move_backward(this->nth(idx), this->end() - 2, this->end() - 1);
+					(*this)[idx] = kerbal::compatibility::to_xvalue(tmp);
+				}
+				return this->nth(idx);
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Up>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::insert(const_iterator pos, const kerbal::assign::assign_list<Up> & src)
+			{
+				return this->insert(pos, src.cbegin(), src.cend());
+			}
+
+#	define __emplace_body(args...) \
+			{ \
+				size_type idx = this->index_of(pos); \
+				if (relocate_by_memcpy::value && this->k_size != this->k_capacity && idx != this->k_size) { \
+					storage_type relocated; \
+					this->__construct_at(&relocated, args); \
+					storage_type * const hole = this->k_buffer + idx; \
+					__relocate(hole, this->k_buffer + this->k_size, hole + 1); \
+					__relocate(&relocated, &relocated + 1, hole); \
+					++this->k_size; \
+					return this->nth(idx); \
+				} \
+				value_type tmp(args); \
+				if (this->k_size == this->k_capacity) { \
+					this->__emplace_realloc(idx, tmp); \
+				} else if (idx == this->k_size) { \
+					this->__construct_at(this->k_buffer + this->k_size, tmp); \
+					++this->k_size; \
+				} else { \
+					this->__construct_at(this->k_buffer + this->k_size, this->back()); \
+					++this->k_size; \
+					kerbal::algorithm::move_backward(this->nth(idx), this->end() - 2, this->end() - 1); \
+					(*this)[idx] = tmp; \
+				} \
+				return this->nth(idx); \
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::emplace(const_iterator pos)
+			{
+				return this->emplace(pos, value_type());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::emplace(const_iterator pos, const Arg0& arg0)
+			{
+				__emplace_body(arg0)
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1)
+			{
+				__emplace_body(arg0, arg1)
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1, typename Arg2>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+			{
+				__emplace_body(arg0, arg1, arg2)
+			}
+
+#	undef __emplace_body
+
+#	endif
+
+			//===================
+			//erase
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::pop_back() KERBAL_NOEXCEPT
+			{
+				--this->k_size;
+				tp_allocator_traits::destroy(this->alloc(), this->k_buffer[this->k_size].raw_pointer());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::erase(const_iterator pos)
+			{
+				size_type idx = this->index_of(pos);
+				if (relocate_by_memcpy::value) {
+					storage_type * const p = this->k_buffer + idx;
+					tp_allocator_traits::destroy(this->alloc(), p->raw_pointer());
+					__relocate(p + 1, this->k_buffer + this->k_size, p);
+					--this->k_size;
+					return this->nth(idx);
+				}
+				kerbal::algorithm::move(this->nth(idx + 1), this->end(), this->nth(idx));
+				this->pop_back();
+				return this->nth(idx);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::erase(const_iterator first, const_iterator last)
+			{
+				size_type idx_first = this->index_of(first);
+				size_type idx_last = this->index_of(last);
+				if (idx_first != idx_last && relocate_by_memcpy::value) {
+					this->__destroy(this->k_buffer + idx_first, this->k_buffer + idx_last);
+					__relocate(this->k_buffer + idx_last, this->k_buffer + this->k_size, this->k_buffer + idx_first);
+					this->k_size -= idx_last - idx_first;
+				} else if (idx_first != idx_last) {
+					iterator new_end(kerbal::algorithm::move(this->nth(idx_last), this->end(), this->nth(idx_first)));
+					size_type new_size = this->index_of(new_end);
+					this->__destroy(this->k_buffer + new_size, this->k_buffer + this->k_size);
+					this->k_size = new_size;
+				}
+				return this->nth(idx_first);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::clear() KERBAL_NOEXCEPT
+			{
+				this->__destroy(this->k_buffer, this->k_buffer + this->k_size);
+				this->k_size = 0;
+			}
+
+			//===================
+			//operation
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::resize(size_type count)
+			{
+				if (count < this->k_size) {
+					this->__destroy(this->k_buffer + count, this->k_buffer + this->k_size);
+					this->k_size = count;
+					return;
+				}
+				if (count > this->k_capacity) {
+					this->__reallocate(this->__recommend_capacity(count - this->k_size));
+				}
+				while (this->k_size != count) {
+					this->__construct_at(this->k_buffer + this->k_size);
+					++this->k_size;
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::resize(size_type count, const_reference value)
+			{
+				if (count < this->k_size) {
+					this->__destroy(this->k_buffer + count, this->k_buffer + this->k_size);
+					this->k_size = count;
+					return;
+				}
+				this->insert(this->cend(), count - this->k_size, value);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::swap(vector_base & ano)
+			{
+				const bool this_inline = this->__is_inline();
+				const bool ano_inline = ano.__is_inline();
+				if (!this_inline && !ano_inline) {
+					this->__swap_type_unrelated(ano);
+				} else if (this_inline && ano_inline) {
+					vector_base & shorter = this->k_size < ano.k_size ? *this : ano;
+					vector_base & longer = this->k_size < ano.k_size ? ano : *this;
+					const size_type common = shorter.k_size;
+					const size_type longer_size = longer.k_size;
+					for (size_type i = 0; i != common; ++i) {
+						kerbal::algorithm::swap(shorter[i], longer[i]);
+					}
+					shorter.__uninitialized_transfer(longer.k_buffer + common, longer.k_buffer + longer_size,
+													shorter.k_buffer + common, relocate_by_memcpy());
+					longer.__destroy_transferred(longer.k_buffer + common, longer.k_buffer + longer_size, relocate_by_memcpy());
+					shorter.k_size = longer_size;
+					longer.k_size = common;
+				} else {
+					// the elements in the inline buffer are moved to the inline buffer of the other one,
+					// who gives its allocated buffer in exchange
+					vector_base & in = this_inline ? *this : ano;
+					vector_base & out = this_inline ? ano : *this;
+					storage_type * const out_buffer = out.k_buffer;
+					const size_type out_size = out.k_size;
+					const size_type out_capacity = out.k_capacity;
+					out.__uninitialized_transfer(in.k_buffer, in.k_buffer + in.k_size, out.__inline_buffer(), relocate_by_memcpy());
+					in.__destroy_transferred(in.k_buffer, in.k_buffer + in.k_size, relocate_by_memcpy());
+					out.k_buffer = out.__inline_buffer();
+					out.k_size = in.k_size;
+					out.k_capacity = N;
+					in.k_buffer = out_buffer;
+					in.k_size = out_size;
+					in.k_capacity = out_capacity;
+				}
+				this->__swap_allocator_helper<tp_allocator_traits::propagate_on_container_swap::value>(ano);
+			}
+
+			//===================
+			//private
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::storage_type *
+			vector_base<Tp, Allocator, N>::__allocate(size_type n)
+			{
+				KERBAL_STATIC_ASSERT(sizeof(storage_type) == sizeof(value_type),
+									 "raw_storage should have the same size as the value type");
+				return reinterpret_cast<storage_type*>(tp_allocator_traits::allocate(this->alloc(), n));
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__deallocate(storage_type * p, size_type n) KERBAL_NOEXCEPT
+			{
+				if (p != this->__inline_buffer()) {
+					tp_allocator_traits::deallocate(this->alloc(), reinterpret_cast<pointer>(p), n);
+				}
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ... Args>
+			void vector_base<Tp, Allocator, N>::__construct_at(storage_type * p, Args&& ... args)
+			{
+				tp_allocator_traits::construct(this->alloc(), p->raw_pointer(), std::forward<Args>(args)...);
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__construct_at(storage_type * p)
+			{
+				tp_allocator_traits::construct(this->alloc(), p->raw_pointer());
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0>
+			void vector_base<Tp, Allocator, N>::__construct_at(storage_type * p, const Arg0& arg0)
+			{
+				tp_allocator_traits::construct(this->alloc(), p->raw_pointer(), arg0);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1>
+			void vector_base<Tp, Allocator, N>::__construct_at(storage_type * p, const Arg0& arg0, const Arg1& arg1)
+			{
+				tp_allocator_traits::construct(this->alloc(), p->raw_pointer(), arg0, arg1);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename Arg0, typename Arg1, typename Arg2>
+			void vector_base<Tp, Allocator, N>::__construct_at(storage_type * p, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+			{
+				tp_allocator_traits::construct(this->alloc(), p->raw_pointer(), arg0, arg1, arg2);
+			}
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__destroy(storage_type * first, storage_type * last) KERBAL_NOEXCEPT
+			{
+				while (last != first) {
+					--last;
+					tp_allocator_traits::destroy(this->alloc(), last->raw_pointer());
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__reset_to_inline() KERBAL_NOEXCEPT
+			{
+				this->k_buffer = this->__inline_buffer();
+				this->k_size = 0;
+				this->k_capacity = N;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			bool vector_base<Tp, Allocator, N>::__is_inline() const KERBAL_NOEXCEPT
+			{
+				return this->k_buffer == this->__inline_buffer();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__release() KERBAL_NOEXCEPT
+			{
+				this->__destroy(this->k_buffer, this->k_buffer + this->k_size);
+				this->__deallocate(this->k_buffer, this->k_capacity);
+				this->__reset_to_inline();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__adopt(storage_type * new_buffer, size_type new_size, size_type new_capacity) KERBAL_NOEXCEPT
+			{
+				this->__release();
+				this->k_buffer = new_buffer;
+				this->k_size = new_size;
+				this->k_capacity = new_capacity;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__steal(vector_base & src) KERBAL_NOEXCEPT
+			{
+				this->k_buffer = src.k_buffer;
+				this->k_size = src.k_size;
+				this->k_capacity = src.k_capacity;
+				src.__reset_to_inline();
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__transfer_construct(vector_base & src)
+			{
+				if (src.k_size > this->k_capacity) {
+					this->k_buffer = this->__allocate(src.k_size);
+					this->k_capacity = src.k_size;
+				}
+#		if __cpp_exceptions
+				try {
+#		endif
+					this->__uninitialized_transfer(src.k_buffer, src.k_buffer + src.k_size, this->k_buffer, relocate_by_memcpy());
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__release();
+					throw;
+				}
+#		endif
+				this->k_size = src.k_size;
+				src.__destroy_transferred(src.k_buffer, src.k_buffer + src.k_size, relocate_by_memcpy());
+				src.k_size = 0;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::size_type
+			vector_base<Tp, Allocator, N>::__recommend_capacity(size_type n) const
+			{
+				const size_type max = this->max_size();
+				if (n > max - this->k_size) {
+					kerbal::utility::throw_this_exception_helper<std::length_error>::throw_this_exception((const char*)"vector exceeds max_size");
+				}
+				if (this->k_capacity >= max / 2) {
+					return max;
+				}
+				size_type new_size = this->k_size + n;
+				size_type new_cap = this->k_capacity * 2;
+				return new_cap < new_size ? new_size : new_cap;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::storage_type *
+			vector_base<Tp, Allocator, N>::__uninitialized_transfer(storage_type * first, storage_type * last, storage_type * to,
+															kerbal::type_traits::false_type)
+			{
+				storage_type * current = to;
+#		if __cpp_exceptions
+				try {
+#		endif
+					for (; first != last; ++first, ++current) {
+#		if __cplusplus >= 201103L
+						this->__construct_at(current, std::move_if_noexcept(first->raw_value()));
+#		else
+						this->__construct_at(current, first->raw_value());
+#		endif
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__destroy(to, current);
+					throw;
+				}
+#		endif
+				return current;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			typename vector_base<Tp, Allocator, N>::storage_type *
+			vector_base<Tp, Allocator, N>::__uninitialized_transfer(storage_type * first, storage_type * last, storage_type * to,
+															kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				std::ptrdiff_t n = last - first;
+				if (n != 0) {
+					std::memcpy(static_cast<void*>(to), static_cast<const void*>(first), n * sizeof(storage_type));
+				}
+				return to + n;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__destroy_transferred(storage_type * first, storage_type * last,
+															kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				this->__destroy(first, last);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__destroy_transferred(storage_type * /*first*/, storage_type * /*last*/,
+															kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__relocate(storage_type * first, storage_type * last, storage_type * to) KERBAL_NOEXCEPT
+			{
+				std::ptrdiff_t n = last - first;
+				if (n != 0) {
+					std::memmove(static_cast<void*>(to), static_cast<const void*>(first), n * sizeof(storage_type));
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__uninitialized_fill_n(storage_type * first, size_type n, const_reference val)
+			{
+				storage_type * current = first;
+#		if __cpp_exceptions
+				try {
+#		endif
+					for (; n != 0; --n, ++current) {
+						this->__construct_at(current, val);
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__destroy(first, current);
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ForwardIterator>
+			void vector_base<Tp, Allocator, N>::__uninitialized_copy(ForwardIterator first, ForwardIterator last, storage_type * to)
+			{
+				storage_type * current = to;
+#		if __cpp_exceptions
+				try {
+#		endif
+					for (; first != last; ++first, ++current) {
+						this->__construct_at(current, *first);
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__destroy(to, current);
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__rebuild_around(storage_type * new_buffer, size_type new_cap, size_type idx, size_type n)
+			{
+				storage_type * const old_first = this->k_buffer;
+				storage_type * const old_mid = old_first + idx;
+				storage_type * const old_last = old_first + this->k_size;
+				storage_type * new_mid = new_buffer;
+#		if __cpp_exceptions
+				try {
+#		endif
+					new_mid = this->__uninitialized_transfer(old_first, old_mid, new_buffer, relocate_by_memcpy());
+					this->__uninitialized_transfer(old_mid, old_last, new_mid + n, relocate_by_memcpy());
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__destroy(new_buffer + idx, new_buffer + idx + n);
+					this->__destroy(new_buffer, new_mid);
+					this->__deallocate(new_buffer, new_cap);
+					throw;
+				}
+#		endif
+				this->__destroy_transferred(old_first, old_last, relocate_by_memcpy());
+				this->__deallocate(old_first, this->k_capacity);
+				this->k_buffer = new_buffer;
+				this->k_size += n;
+				this->k_capacity = new_cap;
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__reallocate(size_type new_cap)
+			{
+				this->__rebuild_around(this->__allocate(new_cap), new_cap, this->k_size, 0);
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ... Args>
+			void vector_base<Tp, Allocator, N>::__emplace_realloc(size_type idx, Args&& ... args)
+			{
+				size_type new_cap = this->__recommend_capacity(1);
+				storage_type * new_buffer = this->__allocate(new_cap);
+#		if __cpp_exceptions
+				try {
+#		endif
+					this->__construct_at(new_buffer + idx, std::forward<Args>(args)...);
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__deallocate(new_buffer, new_cap);
+					throw;
+				}
+#		endif
+				this->__rebuild_around(new_buffer, new_cap, idx, 1);
+			}
+
+#	else
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__emplace_realloc(size_type idx, const_reference val)
+			{
+				size_type new_cap = this->__recommend_capacity(1);
+				storage_type * new_buffer = this->__allocate(new_cap);
+#		if __cpp_exceptions
+				try {
+#		endif
+					this->__construct_at(new_buffer + idx, val);
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__deallocate(new_buffer, new_cap);
+					throw;
+				}
+#		endif
+				this->__rebuild_around(new_buffer, new_cap, idx, 1);
+			}
+
+#	endif
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__fill_construct(size_type n)
+			{
+				if (n > this->k_capacity) {
+					this->k_buffer = this->__allocate(n);
+					this->k_capacity = n;
+				}
+#		if __cpp_exceptions
+				try {
+#		endif
+					while (this->k_size != n) {
+						this->__construct_at(this->k_buffer + this->k_size);
+						++this->k_size;
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__release();
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__fill_construct(size_type n, const_reference val)
+			{
+				if (n > this->k_capacity) {
+					this->k_buffer = this->__allocate(n);
+					this->k_capacity = n;
+				}
+#		if __cpp_exceptions
+				try {
+#		endif
+					while (this->k_size != n) {
+						this->__construct_at(this->k_buffer + this->k_size, val);
+						++this->k_size;
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__release();
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			void vector_base<Tp, Allocator, N>::__range_construct(InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+#		if __cpp_exceptions
+				try {
+#		endif
+					while (first != last) {
+						this->emplace_back(*first);
+						++first;
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__release();
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ForwardIterator>
+			void vector_base<Tp, Allocator, N>::__range_construct(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				size_type n = static_cast<size_type>(kerbal::iterator::distance(first, last));
+				if (n > this->k_capacity) {
+					this->k_buffer = this->__allocate(n);
+					this->k_capacity = n;
+				}
+#		if __cpp_exceptions
+				try {
+#		endif
+					for (; first != last; ++first) {
+						this->__construct_at(this->k_buffer + this->k_size, *first);
+						++this->k_size;
+					}
+#		if __cpp_exceptions
+				} catch (...) {
+					this->__release();
+					throw;
+				}
+#		endif
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			void vector_base<Tp, Allocator, N>::__range_assign(InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				iterator it(this->begin());
+				iterator end(this->end());
+				while (first != last && it != end) {
+					*it = *first;
+					++it;
+					++first;
+				}
+				if (first == last) {
+					this->erase(it, end);
+				} else {
+					while (first != last) {
+						this->emplace_back(*first);
+						++first;
+					}
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ForwardIterator>
+			void vector_base<Tp, Allocator, N>::__range_assign(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				size_type n = static_cast<size_type>(kerbal::iterator::distance(first, last));
+				if (n > this->k_capacity) {
+					storage_type * new_buffer = this->__allocate(n);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_copy(first, last, new_buffer);
+#		if __cpp_exceptions
+					} catch (...) {
+						this->__deallocate(new_buffer, n);
+						throw;
+					}
+#		endif
+					this->__adopt(new_buffer, n, n);
+				} else if (n <= this->k_size) {
+					kerbal::algorithm::copy(first, last, this->begin());
+					this->__destroy(this->k_buffer + n, this->k_buffer + this->k_size);
+					this->k_size = n;
+				} else {
+					ForwardIterator mid(first);
+					kerbal::iterator::advance(mid, this->k_size);
+					kerbal::algorithm::copy(first, mid, this->begin());
+					for (; mid != last; ++mid) {
+						this->__construct_at(this->k_buffer + this->k_size, *mid);
+						++this->k_size;
+					}
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename InputIterator>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::__range_insert(const_iterator pos, InputIterator first, InputIterator last, std::input_iterator_tag)
+			{
+				size_type idx = this->index_of(pos);
+				size_type old_size = this->k_size;
+				while (first != last) {
+					this->emplace_back(*first);
+					++first;
+				}
+				kerbal::algorithm::rotate(this->nth(idx), this->nth(old_size), this->end());
+				return this->nth(idx);
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <typename ForwardIterator>
+			typename vector_base<Tp, Allocator, N>::iterator
+			vector_base<Tp, Allocator, N>::__range_insert(const_iterator pos, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+			{
+				size_type idx = this->index_of(pos);
+				size_type n = static_cast<size_type>(kerbal::iterator::distance(first, last));
+				if (n == 0) {
+					return this->nth(idx);
+				}
+				if (n > this->k_capacity - this->k_size) {
+					size_type new_cap = this->__recommend_capacity(n);
+					storage_type * new_buffer = this->__allocate(new_cap);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_copy(first, last, new_buffer + idx);
+#		if __cpp_exceptions
+					} catch (...) {
+						this->__deallocate(new_buffer, new_cap);
+						throw;
+					}
+#		endif
+					this->__rebuild_around(new_buffer, new_cap, idx, n);
+					return this->nth(idx);
+				}
+
+				const size_type old_size = this->k_size;
+				const size_type elems_after = old_size - idx;
+				if (relocate_by_memcpy::value) {
+					storage_type * const hole = this->k_buffer + idx;
+					__relocate(hole, hole + elems_after, hole + n);
+#		if __cpp_exceptions
+					try {
+#		endif
+						this->__uninitialized_copy(first, last, hole);
+#		if __cpp_exceptions
+					} catch (...) {
+						__relocate(hole + n, hole + n + elems_after, hole);
+						throw;
+					}
+#		endif
+					this->k_size += n;
+				} else if (elems_after > n) {
+					for (size_type i = old_size - n; i != old_size; ++i) {
+						this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::to_xvalue(this->k_buffer[i].raw_value()));
+						++this->k_size;
+					}
+					kerbal::algorithm::move_backward(this->nth(idx), this->nth(old_size - n), this->nth(old_size));
+					kerbal::algorithm::copy(first, last, this->nth(idx));
+				} else {
+					ForwardIterator mid(first);
+					kerbal::iterator::advance(mid, elems_after);
+					for (ForwardIterator it(mid); it != last; ++it) {
+						this->__construct_at(this->k_buffer + this->k_size, *it);
+						++this->k_size;
+					}
+					for (size_type i = idx; i != old_size; ++i) {
+						this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::to_xvalue(this->k_buffer[i].raw_value()));
+						++this->k_size;
+					}
+					kerbal::algorithm::copy(first, mid, this->nth(idx));
+				}
+				return this->nth(idx);
+			}
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <bool propagate_on_container_move_assignment>
+			typename kerbal::type_traits::enable_if<!propagate_on_container_move_assignment>::type
+			vector_base<Tp, Allocator, N>::__move_assign_helper(vector_base && src)
+			{
+				if (!src.__is_inline() && this->alloc() == src.alloc()) {
+					this->__release();
+					this->__steal(src);
+				} else {
+					this->__move_assign_elements(src);
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			template <bool propagate_on_container_move_assignment>
+			typename kerbal::type_traits::enable_if<propagate_on_container_move_assignment>::type
+			vector_base<Tp, Allocator, N>::__move_assign_helper(vector_base && src)
+			{
+				this->__release();
+				this->alloc() = kerbal::compatibility::move(src.alloc());
+				if (src.__is_inline()) {
+					this->__move_assign_elements(src);
+				} else {
+					this->__steal(src);
+				}
+			}
+
+			template <typename Tp, typename Allocator, size_t N>
+			void vector_base<Tp, Allocator, N>::__move_assign_elements(vector_base & src)
+			{
+				this->clear();
+				this->reserve(src.k_size);
+				for (size_type i = 0; i != src.k_size; ++i) {
+					this->__construct_at(this->k_buffer + this->k_size, kerbal::compatibility::move(src[i]));
+					++this->k_size;
+				}
+				src.clear();
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_IMPL_VECTOR_BASE_IMPL_HPP
@@ -612,7 +612,7 @@ namespace kerbal
 				template <bool propagate_on_container_swap>
 				KERBAL_CONSTEXPR20
 				typename kerbal::type_traits::enable_if<!propagate_on_container_swap>::type
-				swap_allocator_helper()
+				swap_allocator_helper(list & /*ano*/)
 				{
 				}
 
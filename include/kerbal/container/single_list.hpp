@@ -430,6 +430,8 @@ namespace kerbal
 
 				using sl_allocator_unrelated::reverse;
 
+				using sl_allocator_unrelated::sort;
+
 
 				KERBAL_CONSTEXPR20
 				void splice(const_iterator pos, single_list & other) KERBAL_NOEXCEPT;
@@ -537,7 +539,7 @@ namespace kerbal
 				template <bool propagate_on_container_swap>
 				KERBAL_CONSTEXPR20
 				typename kerbal::type_traits::enable_if<!propagate_on_container_swap>::type
-				swap_allocator_helper()
+				swap_allocator_helper(single_list & /*ano*/)
 				{
 				}
 
@@ -0,0 +1,280 @@
+/**
+ * @file       small_vector.hpp
+ * @brief
+ * @date       2020-09-08
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_SMALL_VECTOR_HPP
+#define KERBAL_CONTAINER_SMALL_VECTOR_HPP
+
+#include <kerbal/algorithm/sequence_compare.hpp>
+#include <kerbal/assign/ilist.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/enable_if.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#if __cplusplus >= 201103L
+#	include <initializer_list>
+#	include <type_traits>
+#endif
+
+#if __cplusplus >= 201703L
+#	if __has_include(<memory_resource>)
+#		include <memory_resource>
+#	endif
+#endif
+
+#include <kerbal/container/detail/vector_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * @brief Array with flexible length that stores up to N elements inside itself.
+		 * @details The small_vector has the same interface with static_vector, while it is not limited
+		 *          by N: once the elements outnumber N, they are moved to the storage got from the
+		 *          allocator, and the small_vector behaves like a vector since then. That makes it
+		 *          suitable for the sequences which are short at most of the time.
+		 *          The storage goes back to the inline one after shrink_to_fit if not more than N
+		 *          elements remain. Unlike vector, swap and move of the inline elements are done
+		 *          element by element and invalidate the iterators.
+		 * @tparam Tp Type of the elements.
+		 * @tparam N The number of elements that could be held without allocation.
+		 * @tparam Allocator Allocator of Tp.
+		 */
+		template <typename Tp, std::size_t N, typename Allocator = std::allocator<Tp> >
+		class small_vector:
+				public kerbal::container::detail::vector_base<Tp, Allocator, N>
+		{
+			private:
+				typedef kerbal::container::detail::vector_base<Tp, Allocator, N>		super;
+
+			public:
+				typedef typename super::value_type					value_type;
+				typedef typename super::const_type					const_type;
+				typedef typename super::reference					reference;
+				typedef typename super::const_reference				const_reference;
+				typedef typename super::pointer						pointer;
+				typedef typename super::const_pointer				const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef typename super::rvalue_reference			rvalue_reference;
+				typedef typename super::const_rvalue_reference		const_rvalue_reference;
+#		endif
+
+				typedef typename super::size_type					size_type;
+				typedef typename super::difference_type				difference_type;
+
+				typedef typename super::iterator					iterator;
+				typedef typename super::const_iterator				const_iterator;
+				typedef typename super::reverse_iterator			reverse_iterator;
+				typedef typename super::const_reverse_iterator		const_reverse_iterator;
+
+				typedef typename super::allocator_type				allocator_type;
+
+			public:
+				small_vector()
+						: super()
+				{
+				}
+
+				explicit small_vector(const Allocator& alloc)
+						: super(alloc)
+				{
+				}
+
+				small_vector(const small_vector & src)
+						: super(static_cast<const super&>(src))
+				{
+				}
+
+				small_vector(const small_vector & src, const Allocator& alloc)
+						: super(static_cast<const super&>(src), alloc)
+				{
+				}
+
+				explicit small_vector(size_type n)
+						: super(n)
+				{
+				}
+
+				small_vector(size_type n, const Allocator& alloc)
+						: super(n, alloc)
+				{
+				}
+
+				small_vector(size_type n, const_reference val)
+						: super(n, val)
+				{
+				}
+
+				small_vector(size_type n, const_reference val, const Allocator& alloc)
+						: super(n, val, alloc)
+				{
+				}
+
+				template <typename InputIterator>
+				small_vector(InputIterator first, InputIterator last,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				)
+						: super(first, last)
+				{
+				}
+
+				template <typename InputIterator>
+				small_vector(InputIterator first, InputIterator last, const Allocator& alloc,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				)
+						: super(first, last, alloc)
+				{
+				}
+
+#		if __cplusplus >= 201103L
+
+				small_vector(small_vector && src)
+						KERBAL_CONDITIONAL_NOEXCEPT(
+								std::is_nothrow_move_constructible<Tp>::value
+						)
+						: super(static_cast<super&&>(src))
+				{
+				}
+
+				small_vector(small_vector && src, const Allocator& alloc)
+						: super(static_cast<super&&>(src), alloc)
+				{
+				}
+
+				small_vector(std::initializer_list<value_type> src)
+						: super(src)
+				{
+				}
+
+				small_vector(std::initializer_list<value_type> src, const Allocator& alloc)
+						: super(src, alloc)
+				{
+				}
+
+#		else
+
+				template <typename Up>
+				small_vector(const kerbal::assign::assign_list<Up> & src)
+						: super(src)
+				{
+				}
+
+				template <typename Up>
+				small_vector(const kerbal::assign::assign_list<Up> & src, const Allocator& alloc)
+						: super(src, alloc)
+				{
+				}
+
+#		endif
+
+			//===================
+			//assign
+
+				small_vector& operator=(const small_vector & src)
+				{
+					super::operator=(static_cast<const super&>(src));
+					return *this;
+				}
+
+#		if __cplusplus >= 201103L
+
+				small_vector& operator=(small_vector && src)
+				{
+					super::operator=(static_cast<super&&>(src));
+					return *this;
+				}
+
+				small_vector& operator=(std::initializer_list<value_type> src)
+				{
+					super::operator=(src);
+					return *this;
+				}
+
+#		else
+
+				template <typename Up>
+				small_vector& operator=(const kerbal::assign::assign_list<Up> & src)
+				{
+					super::operator=(src);
+					return *this;
+				}
+
+#		endif
+
+		};
+
+#	if __cplusplus >= 201703L
+#	if __has_include(<memory_resource>)
+
+		namespace pmr
+		{
+			template <typename Tp, std::size_t N>
+			using small_vector = kerbal::container::small_vector<Tp, N, std::pmr::polymorphic_allocator<Tp> >;
+		}
+
+#	endif
+#	endif
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator==(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return lhs.size() == rhs.size() &&
+					kerbal::algorithm::sequence_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator!=(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return lhs.size() != rhs.size() ||
+					kerbal::algorithm::sequence_not_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator<(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator>(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator<=(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, std::size_t M, typename Allocator, std::size_t N, typename Allocator2>
+		bool operator>=(const small_vector<Tp, M, Allocator> & lhs, const small_vector<Tp, N, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_SMALL_VECTOR_HPP
@@ -17,6 +17,7 @@
 #include <kerbal/container/static_vector.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
 #include <kerbal/type_traits/enable_if.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 
 #if __cplusplus >= 201103L
 #	include <initializer_list>
@@ -29,7 +30,11 @@ namespace kerbal
 	namespace container
 	{
 
-		template <typename Tp, size_t N, typename KeyCompare = std::less<Tp> >
+		/**
+		 * @tparam ARITY number of children of each node of the heap, e.g. 4 or 8 to keep the children of a node
+		 *         in one cache line.
+		 */
+		template <typename Tp, size_t N, typename KeyCompare = std::less<Tp>, size_t ARITY = 2>
 		class static_priority_queue
 		{
 			public:
@@ -56,6 +61,8 @@ namespace kerbal
 
 
 			private:
+				typedef kerbal::type_traits::integral_constant<size_t, ARITY> arity;
+
 				container_type c;
 				value_compare vc;
 
@@ -81,7 +88,7 @@ namespace kerbal
 						>::type = 0) :
 						c(first, last), vc()
 				{
-					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc);
+					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc, arity());
 				}
 
 				template <typename InputIterator>
@@ -93,7 +100,7 @@ namespace kerbal
 						>::type = 0) :
 						c(first, last), vc(kc)
 				{
-					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc);
+					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc, arity());
 				}
 
 #		if __cplusplus >= 201103L
@@ -146,17 +153,46 @@ namespace kerbal
 				void push(const_reference val)
 				{
 					c.push_back(val);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
+				/**
+				 * @brief Append all the m elements of [first, last), then heapify them together, which is
+				 *        O(m + log(n) ^ 2) instead of O(m log n) by pushing them one by one.
+				 */
 				template <typename InputIterator>
-				KERBAL_CONSTEXPR14
+				KERBAL_CONSTEXPR20
 				void push(InputIterator first, InputIterator last)
 				{
-					while (first != last) {
-						this->push(*first);
-						++first;
+					size_type old_size = c.size();
+
+#			if __cpp_exceptions
+					try {
+#			endif // __cpp_exceptions
+
+						while (first != last) {
+							c.push_back(*first);
+							++first;
+						}
+
+#			if __cpp_exceptions
+					} catch (...) {
+						kerbal::algorithm::push_heap(c.begin(), c.nth(old_size), c.end(), vc, arity());
+						throw;
 					}
+#			endif // __cpp_exceptions
+
+					kerbal::algorithm::push_heap(c.begin(), c.nth(old_size), c.end(), vc, arity());
+				}
+
+				/**
+				 * @brief Push all the elements of another priority queue, see push(first, last).
+				 */
+				template <size_t M>
+				KERBAL_CONSTEXPR20
+				void merge(const static_priority_queue<Tp, M, KeyCompare, ARITY> & other)
+				{
+					this->push(other.cbegin(), other.cend());
 				}
 
 #		if __cplusplus >= 201103L
@@ -165,7 +201,7 @@ namespace kerbal
 				void push(rvalue_reference val)
 				{
 					c.push_back(kerbal::compatibility::move(val));
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 #		endif
@@ -177,7 +213,7 @@ namespace kerbal
 				void emplace(Args&& ... args)
 				{
 					c.emplace_back(std::forward<Args>(args)...);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 #		else
@@ -185,28 +221,28 @@ namespace kerbal
 				void emplace()
 				{
 					c.emplace_back();
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 				template <typename Arg0>
 				void emplace(const Arg0& arg0)
 				{
 					c.emplace_back(arg0);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 				template <typename Arg0, typename Arg1>
 				void emplace(const Arg0& arg0, const Arg1& arg1)
 				{
 					c.emplace_back(arg0, arg1);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 				template <typename Arg0, typename Arg1, typename Arg2>
 				void emplace(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
 				{
 					c.emplace_back(arg0, arg1, arg2);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap(c.begin(), c.end(), vc, arity());
 				}
 
 #		endif
@@ -214,13 +250,13 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void pop()
 				{
-					kerbal::algorithm::pop_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::pop_heap(c.begin(), c.end(), vc, arity());
 					c.pop_back();
 				}
 
 				template <size_t M>
 				KERBAL_CONSTEXPR14
-				void swap(static_priority_queue<Tp, M> & with)
+				void swap(static_priority_queue<Tp, M, KeyCompare, ARITY> & with)
 				{
 					c.swap(with);
 					kerbal::algorithm::swap(this->vc, with.vc);
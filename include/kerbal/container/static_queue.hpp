@@ -13,10 +13,14 @@
 #define KERBAL_CONTAINER_STATIC_QUEUE_HPP
 
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/is_trivially_copyable.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
 
 #include <cstddef>
+#include <cstring>
 
 #if __cplusplus >= 201103L
 #	include <initializer_list>
@@ -60,6 +64,10 @@ namespace kerbal
 				static_queue(const static_queue & src)
 						: super()
 				{
+					if (this->__memcpy_enabled()) {
+						this->__memcpy_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
 						this->push(src.storage[j].raw_value());
 					}
@@ -67,13 +75,21 @@ namespace kerbal
 
 #			if __cplusplus >= 201103L
 
+				/*
+				 * The move constructor and the move assignment leave src empty.
+				 */
 				KERBAL_CONSTEXPR14
 				static_queue(static_queue && src)
 						: super()
 				{
+					if (this->__relocate_enabled()) {
+						this->__relocate_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
 						this->push(kerbal::compatibility::move(src.storage[j].raw_value()));
 					}
+					src.clear();
 				}
 
 #			endif
@@ -120,9 +136,16 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void assign(const static_queue & src)
 				{
+					if (this == &src) {
+						return;
+					}
 					this->clear();
+					if (this->__memcpy_enabled()) {
+						this->__memcpy_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
-						this->push(this->storage[j].raw_value());
+						this->push(src.storage[j].raw_value());
 					}
 				}
 
@@ -131,10 +154,18 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void assign(static_queue && src)
 				{
+					if (this == &src) {
+						return;
+					}
 					this->clear();
+					if (this->__relocate_enabled()) {
+						this->__relocate_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
-						this->push(kerbal::compatibility::move(this->storage[j].raw_value()));
+						this->push(kerbal::compatibility::move(src.storage[j].raw_value()));
 					}
+					src.clear();
 				}
 
 #			endif
@@ -262,6 +293,53 @@ namespace kerbal
 
 				void swap(static_queue& with);
 
+			private:
+
+				/*
+				 * Whether the elements could be copied by memcpy at present,
+				 * which is never true while the evaluation is at compile time.
+				 */
+				KERBAL_CONSTEXPR14
+				static bool __memcpy_enabled() KERBAL_NOEXCEPT
+				{
+					return kerbal::type_traits::is_trivially_copyable<value_type>::value && !KERBAL_MAY_BE_CONSTANT_EVALUATED();
+				}
+
+				/*
+				 * Whether the elements could be moved by memcpy at present, leaving the source empty
+				 * without destroying them.
+				 */
+				KERBAL_CONSTEXPR14
+				static bool __relocate_enabled() KERBAL_NOEXCEPT
+				{
+					return kerbal::type_traits::is_trivially_relocatable<value_type>::value && !KERBAL_MAY_BE_CONSTANT_EVALUATED();
+				}
+
+				// pre-cond: this is empty
+				void __memcpy_from(const static_queue & src) KERBAL_NOEXCEPT
+				{
+					typedef typename super::storage_type storage_type;
+
+					this->ibegin = src.ibegin;
+					this->iend = src.iend;
+					if (src.ibegin <= src.iend) {
+						std::memcpy(static_cast<void*>(this->storage + src.ibegin), static_cast<const void*>(src.storage + src.ibegin),
+									(src.iend - src.ibegin) * sizeof(storage_type));
+					} else { // the elements are wrapped around
+						std::memcpy(static_cast<void*>(this->storage + src.ibegin), static_cast<const void*>(src.storage + src.ibegin),
+									(N + 1 - src.ibegin) * sizeof(storage_type));
+						std::memcpy(static_cast<void*>(this->storage), static_cast<const void*>(src.storage),
+									src.iend * sizeof(storage_type));
+					}
+				}
+
+				// pre-cond: this is empty
+				void __relocate_from(static_queue & src) KERBAL_NOEXCEPT
+				{
+					this->__memcpy_from(src);
+					src.iend = src.ibegin;
+				}
+
 		};
 
 	} // namespace container
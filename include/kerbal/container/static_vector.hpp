@@ -127,6 +127,10 @@ namespace kerbal
 
 #		if __cplusplus >= 201103L
 
+				/**
+				 * @brief Move constructor
+				 * @param src the static_vector the elements are moved from, which is left empty
+				 */
 				KERBAL_CONSTEXPR14
 				static_vector(static_vector && src);
 
@@ -567,6 +571,27 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void __destroy_at(iterator);
 
+				/*
+				 * Whether the elements could be copied by memcpy at present,
+				 * which is never true while the evaluation is at compile time.
+				 */
+				KERBAL_CONSTEXPR14
+				static bool __memcpy_enabled() KERBAL_NOEXCEPT;
+
+				void __memcpy_from(const static_vector & src) KERBAL_NOEXCEPT;
+
+				/*
+				 * Whether the elements could be moved or shifted by memcpy / memmove at present,
+				 * the elements relocated are never destroyed at the old place.
+				 */
+				KERBAL_CONSTEXPR14
+				static bool __relocate_enabled() KERBAL_NOEXCEPT;
+
+				// tmp is relocated into the hole at index, never destroy it after that
+				iterator __relocate_insert(size_type index, storage_type & tmp) KERBAL_NOEXCEPT;
+
+				iterator __relocate_erase(size_type first, size_type last) KERBAL_NOEXCEPT;
+
 		};
 
 		template <typename Tp, size_t M, size_t N>
@@ -0,0 +1,297 @@
+/**
+ * @file       vector.hpp
+ * @brief
+ * @date       2020-09-07
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_VECTOR_HPP
+#define KERBAL_CONTAINER_VECTOR_HPP
+
+#include <kerbal/algorithm/sequence_compare.hpp>
+#include <kerbal/assign/ilist.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/enable_if.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#if __cplusplus >= 201103L
+#	include <initializer_list>
+#endif
+
+#if __cplusplus >= 201703L
+#	if __has_include(<memory_resource>)
+#		include <memory_resource>
+#	endif
+#endif
+
+#include <kerbal/container/detail/vector_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * @brief Array with flexible length that stored on the storage got from the allocator.
+		 * @details The vector shares the iterator with static_vector, but grows geometrically
+		 *          when the capacity is exhausted. The trivially copyable elements are moved to
+		 *          the new storage by memcpy while growing.
+		 * @tparam Tp Type of the elements.
+		 * @tparam Allocator Allocator of Tp.
+		 */
+		template <typename Tp, typename Allocator = std::allocator<Tp> >
+		class vector:
+				public kerbal::container::detail::vector_base<Tp, Allocator, 0>
+		{
+			private:
+				typedef kerbal::container::detail::vector_base<Tp, Allocator, 0>		super;
+
+			public:
+				typedef typename super::value_type					value_type;
+				typedef typename super::const_type					const_type;
+				typedef typename super::reference					reference;
+				typedef typename super::const_reference				const_reference;
+				typedef typename super::pointer						pointer;
+				typedef typename super::const_pointer				const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef typename super::rvalue_reference			rvalue_reference;
+				typedef typename super::const_rvalue_reference		const_rvalue_reference;
+#		endif
+
+				typedef typename super::size_type					size_type;
+				typedef typename super::difference_type				difference_type;
+
+				typedef typename super::iterator					iterator;
+				typedef typename super::const_iterator				const_iterator;
+				typedef typename super::reverse_iterator			reverse_iterator;
+				typedef typename super::const_reverse_iterator		const_reverse_iterator;
+
+				typedef typename super::allocator_type				allocator_type;
+
+			public:
+				vector()
+						: super()
+				{
+				}
+
+				explicit vector(const Allocator& alloc)
+						: super(alloc)
+				{
+				}
+
+				vector(const vector & src)
+						: super(static_cast<const super&>(src))
+				{
+				}
+
+				vector(const vector & src, const Allocator& alloc)
+						: super(static_cast<const super&>(src), alloc)
+				{
+				}
+
+				explicit vector(size_type n)
+						: super(n)
+				{
+				}
+
+				vector(size_type n, const Allocator& alloc)
+						: super(n, alloc)
+				{
+				}
+
+				vector(size_type n, const_reference val)
+						: super(n, val)
+				{
+				}
+
+				vector(size_type n, const_reference val, const Allocator& alloc)
+						: super(n, val, alloc)
+				{
+				}
+
+				template <typename InputIterator>
+				vector(InputIterator first, InputIterator last,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				)
+						: super(first, last)
+				{
+				}
+
+				template <typename InputIterator>
+				vector(InputIterator first, InputIterator last, const Allocator& alloc,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				)
+						: super(first, last, alloc)
+				{
+				}
+
+#		if __cplusplus >= 201103L
+
+				vector(vector && src) KERBAL_NOEXCEPT
+						: super(static_cast<super&&>(src))
+				{
+				}
+
+				vector(vector && src, const Allocator& alloc)
+						: super(static_cast<super&&>(src), alloc)
+				{
+				}
+
+				vector(std::initializer_list<value_type> src)
+						: super(src)
+				{
+				}
+
+				vector(std::initializer_list<value_type> src, const Allocator& alloc)
+						: super(src, alloc)
+				{
+				}
+
+#		else
+
+				template <typename Up>
+				vector(const kerbal::assign::assign_list<Up> & src)
+						: super(src)
+				{
+				}
+
+				template <typename Up>
+				vector(const kerbal::assign::assign_list<Up> & src, const Allocator& alloc)
+						: super(src, alloc)
+				{
+				}
+
+#		endif
+
+			//===================
+			//assign
+
+				vector& operator=(const vector & src)
+				{
+					super::operator=(static_cast<const super&>(src));
+					return *this;
+				}
+
+#		if __cplusplus >= 201103L
+
+				vector& operator=(vector && src)
+				{
+					super::operator=(static_cast<super&&>(src));
+					return *this;
+				}
+
+				vector& operator=(std::initializer_list<value_type> src)
+				{
+					super::operator=(src);
+					return *this;
+				}
+
+#		else
+
+				template <typename Up>
+				vector& operator=(const kerbal::assign::assign_list<Up> & src)
+				{
+					super::operator=(src);
+					return *this;
+				}
+
+#		endif
+
+		};
+
+#	if __cplusplus >= 201703L
+
+		template <typename InputIterator, typename Alloc =
+					std::allocator<typename kerbal::iterator::iterator_traits<InputIterator>::value_type> >
+		vector(InputIterator, InputIterator, Alloc = Alloc())
+				-> vector<typename kerbal::iterator::iterator_traits<InputIterator>::value_type, Alloc>;
+
+		template <typename Tp, typename Alloc = std::allocator<Tp> >
+		vector(std::initializer_list<Tp> src, Alloc = Alloc()) -> vector<Tp, Alloc>;
+
+#	if __has_include(<memory_resource>)
+
+		namespace pmr
+		{
+			template <typename Tp>
+			using vector = kerbal::container::vector<Tp, std::pmr::polymorphic_allocator<Tp> >;
+		}
+
+#	endif
+
+#	endif
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator==(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return lhs.size() == rhs.size() &&
+					kerbal::algorithm::sequence_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator!=(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return lhs.size() != rhs.size() ||
+					kerbal::algorithm::sequence_not_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator<(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator>(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator<=(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Allocator, typename Allocator2>
+		bool operator>=(const vector<Tp, Allocator> & lhs, const vector<Tp, Allocator2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+	} // namespace container
+
+	namespace type_traits
+	{
+
+		/*
+		 * The vector with std::allocator holds nothing but the pointer to the elements and the sizes.
+		 */
+		template <typename Tp>
+		struct is_trivially_relocatable<kerbal::container::vector<Tp, std::allocator<Tp> > >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_VECTOR_HPP
@@ -0,0 +1,295 @@
+/**
+ * @file       fixed_size_pool.hpp
+ * @brief
+ * @date       2020-09-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_MEMORY_DETAIL_FIXED_SIZE_POOL_HPP
+#define KERBAL_MEMORY_DETAIL_FIXED_SIZE_POOL_HPP
+
+#include <kerbal/compatibility/alignof.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/utility/noncopyable.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace kerbal
+{
+
+	namespace memory
+	{
+
+		namespace detail
+		{
+
+			union fixed_size_pool_max_align
+			{
+					long double ld;
+					long long ll;
+					double d;
+					void * p;
+					void (*fp)();
+			};
+
+			/*
+			 * Blocks of one size carved from slabs got from the global operator new.
+			 *
+			 * Each block is preceded by one word, which points to the slab it belongs to while the block is in use,
+			 * and links the next free block of the same slab while it is free. So the slab of a block, and the pool
+			 * owning the slab, are found in O(1) when it is given back, and the slab is given back to the operator
+			 * delete as soon as it becomes empty, except the last empty one, which is kept to avoid thrashing at the
+			 * boundary.
+			 *
+			 * The slabs having free blocks are linked in a list, the partially used ones in the front and the empty
+			 * ones at the back, so that the new blocks are taken from the fuller slabs. The full slabs are unlinked.
+			 */
+			class fixed_size_pool:
+					private kerbal::utility::noncopyable
+			{
+				public:
+					typedef std::size_t size_type;
+
+					static const size_type MAX_ALIGN = KERBAL_ALIGNOF(fixed_size_pool_max_align);
+
+				private:
+					struct slab
+					{
+							fixed_size_pool * owner;
+							slab * prev;
+							slab * next;
+							void * free_list; // blocks given back
+							char * unused; // blocks never handed out start here
+							size_type used;
+					};
+
+					static
+					size_type round_up(size_type n, size_type align) KERBAL_NOEXCEPT
+					{
+						return (n + align - 1) / align * align;
+					}
+
+					slab * k_head;
+					slab * k_tail;
+					size_type k_slabs;
+					size_type k_empty_slabs;
+
+					size_type k_block_size;
+					size_type k_block_align;
+					size_type k_header_size;
+					size_type k_stride;
+					size_type k_first_offset;
+					size_type k_blocks_per_slab;
+
+				public:
+
+					/*
+					 * @param blocks_per_slab 0 for about 4 KiB per slab
+					 * pre-cond: block_align is power of 2 and not greater than MAX_ALIGN
+					 */
+					fixed_size_pool(size_type block_size, size_type block_align, size_type blocks_per_slab) KERBAL_NOEXCEPT :
+							k_head(NULL), k_tail(NULL), k_slabs(0), k_empty_slabs(0),
+							k_block_size(block_size), k_block_align(block_align)
+					{
+						size_type align = block_align < sizeof(void*) ? sizeof(void*) : block_align;
+						this->k_header_size = header_size(block_align);
+						this->k_stride = round_up(this->k_header_size + block_size, align);
+						this->k_first_offset = round_up(sizeof(slab), align);
+						if (blocks_per_slab == 0) {
+							blocks_per_slab = this->k_first_offset + 8 * this->k_stride < 4096 ?
+												(4096 - this->k_first_offset) / this->k_stride : 8;
+						}
+						this->k_blocks_per_slab = blocks_per_slab;
+					}
+
+					/*
+					 * pre-cond: all the blocks have been given back
+					 */
+					~fixed_size_pool() KERBAL_NOEXCEPT
+					{
+						while (this->k_head != NULL) {
+							slab * s = this->k_head;
+							this->k_head = s->next;
+							::operator delete(static_cast<void*>(s));
+						}
+					}
+
+					size_type block_size() const KERBAL_NOEXCEPT
+					{
+						return this->k_block_size;
+					}
+
+					size_type block_align() const KERBAL_NOEXCEPT
+					{
+						return this->k_block_align;
+					}
+
+					size_type blocks_per_slab() const KERBAL_NOEXCEPT
+					{
+						return this->k_blocks_per_slab;
+					}
+
+					/*
+					 * number of the slabs held, including the empty one kept
+					 */
+					size_type slabs() const KERBAL_NOEXCEPT
+					{
+						return this->k_slabs;
+					}
+
+					/*
+					 * The pool which the block came from, given the alignment the block was allocated with.
+					 * pre-cond: p is got from allocate of a pool whose block_align is block_align
+					 */
+					static fixed_size_pool * owner_of(void * p, size_type block_align) KERBAL_NOEXCEPT
+					{
+						char * block = static_cast<char*>(p) - header_size(block_align);
+						return (*reinterpret_cast<slab**>(block))->owner;
+					}
+
+					/*
+					 * give the empty slabs back to the operator delete
+					 */
+					void shrink() KERBAL_NOEXCEPT
+					{
+						while (this->k_empty_slabs != 0) {
+							slab * s = this->k_tail; // the empty slabs are at the back
+							this->unlink(s);
+							this->release_slab(s);
+							--this->k_empty_slabs;
+						}
+					}
+
+					/*
+					 * Whether the objects with the size and alignment could be placed in the blocks
+					 */
+					bool accept(size_type size, size_type align) const KERBAL_NOEXCEPT
+					{
+						return size == this->k_block_size && align <= this->k_block_align;
+					}
+
+					void * allocate()
+					{
+						slab * s = this->k_head;
+						if (s == NULL) {
+							s = this->new_slab();
+						}
+						char * block;
+						if (s->free_list != NULL) {
+							block = static_cast<char*>(s->free_list);
+							s->free_list = *reinterpret_cast<void**>(block);
+						} else {
+							block = s->unused;
+							s->unused += this->k_stride;
+						}
+						if (s->used == 0) {
+							--this->k_empty_slabs;
+						}
+						++s->used;
+						if (s->used == this->k_blocks_per_slab) {
+							this->unlink(s);
+						}
+						*reinterpret_cast<slab**>(block) = s;
+						return block + this->k_header_size;
+					}
+
+					void deallocate(void * p) KERBAL_NOEXCEPT
+					{
+						char * block = static_cast<char*>(p) - this->k_header_size;
+						slab * s = *reinterpret_cast<slab**>(block);
+						if (s->used == this->k_blocks_per_slab) {
+							this->link_front(s);
+						}
+						*reinterpret_cast<void**>(block) = s->free_list;
+						s->free_list = block;
+						--s->used;
+						if (s->used == 0) {
+							this->unlink(s);
+							if (this->k_empty_slabs != 0) {
+								this->release_slab(s);
+							} else {
+								this->link_back(s);
+								++this->k_empty_slabs;
+							}
+						}
+					}
+
+				private:
+					static
+					size_type header_size(size_type block_align) KERBAL_NOEXCEPT
+					{
+						return round_up(sizeof(void*), block_align < sizeof(void*) ? sizeof(void*) : block_align);
+					}
+
+					slab * new_slab()
+					{
+						void * mem = ::operator new(this->k_first_offset + this->k_blocks_per_slab * this->k_stride);
+						slab * s = static_cast<slab*>(mem);
+						s->owner = this;
+						s->free_list = NULL;
+						s->unused = static_cast<char*>(mem) + this->k_first_offset;
+						s->used = 0;
+						this->link_front(s);
+						++this->k_slabs;
+						++this->k_empty_slabs;
+						return s;
+					}
+
+					void release_slab(slab * s) KERBAL_NOEXCEPT
+					{
+						::operator delete(static_cast<void*>(s));
+						--this->k_slabs;
+					}
+
+					void link_front(slab * s) KERBAL_NOEXCEPT
+					{
+						s->prev = NULL;
+						s->next = this->k_head;
+						if (this->k_head != NULL) {
+							this->k_head->prev = s;
+						} else {
+							this->k_tail = s;
+						}
+						this->k_head = s;
+					}
+
+					void link_back(slab * s) KERBAL_NOEXCEPT
+					{
+						s->prev = this->k_tail;
+						s->next = NULL;
+						if (this->k_tail != NULL) {
+							this->k_tail->next = s;
+						} else {
+							this->k_head = s;
+						}
+						this->k_tail = s;
+					}
+
+					void unlink(slab * s) KERBAL_NOEXCEPT
+					{
+						if (s->prev != NULL) {
+							s->prev->next = s->next;
+						} else {
+							this->k_head = s->next;
+						}
+						if (s->next != NULL) {
+							s->next->prev = s->prev;
+						} else {
+							this->k_tail = s->prev;
+						}
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace memory
+
+} // namespace kerbal
+
+#endif // KERBAL_MEMORY_DETAIL_FIXED_SIZE_POOL_HPP
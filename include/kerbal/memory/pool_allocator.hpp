@@ -0,0 +1,311 @@
+/**
+ * @file       pool_allocator.hpp
+ * @brief
+ * @date       2020-09-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_MEMORY_POOL_ALLOCATOR_HPP
+#define KERBAL_MEMORY_POOL_ALLOCATOR_HPP
+
+#include <kerbal/compatibility/alignof.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include <kerbal/memory/detail/fixed_size_pool.hpp>
+
+namespace kerbal
+{
+
+	namespace memory
+	{
+
+		namespace detail
+		{
+
+			struct pool_allocator_state;
+
+			struct pool_allocator_pool:
+					public kerbal::memory::detail::fixed_size_pool
+			{
+					pool_allocator_state * state;
+					pool_allocator_pool * next;
+
+					pool_allocator_pool(pool_allocator_state * state, pool_allocator_pool * next,
+										std::size_t block_size, std::size_t block_align, std::size_t blocks_per_slab) KERBAL_NOEXCEPT :
+							fixed_size_pool(block_size, block_align, blocks_per_slab), state(state), next(next)
+					{
+					}
+			};
+
+			/*
+			 * The pools shared by the copies of one pool_allocator, one for each size and alignment of the objects.
+			 *
+			 * The blocks may outlive all the allocators, when the nodes are spliced to a container using another
+			 * allocator. So the state is freed at the later of the last allocator released and the last block given
+			 * back.
+			 */
+			struct pool_allocator_state
+			{
+					std::size_t ref_count;
+					std::size_t blocks_per_slab;
+					pool_allocator_pool * pools;
+
+					explicit pool_allocator_state(std::size_t blocks_per_slab) KERBAL_NOEXCEPT :
+							ref_count(1), blocks_per_slab(blocks_per_slab), pools(NULL)
+					{
+					}
+
+					~pool_allocator_state() KERBAL_NOEXCEPT
+					{
+						while (this->pools != NULL) {
+							pool_allocator_pool * pool = this->pools;
+							this->pools = pool->next;
+							delete pool;
+						}
+					}
+
+					pool_allocator_pool & pool_of(std::size_t block_size, std::size_t block_align)
+					{
+						for (pool_allocator_pool * pool = this->pools; pool != NULL; pool = pool->next) {
+							if (pool->block_size() == block_size && pool->block_align() == block_align) {
+								return *pool;
+							}
+						}
+						this->pools = new pool_allocator_pool(this, this->pools, block_size, block_align, this->blocks_per_slab);
+						return *this->pools;
+					}
+
+					/*
+					 * Free the state if no allocator refers to it and all the blocks have been given back
+					 */
+					static void collect(pool_allocator_state * state) KERBAL_NOEXCEPT
+					{
+						if (state->ref_count != 0) {
+							return;
+						}
+						for (pool_allocator_pool * pool = state->pools; pool != NULL; pool = pool->next) {
+							pool->shrink();
+							if (pool->slabs() != 0) {
+								return;
+							}
+						}
+						delete state;
+					}
+			};
+
+		} // namespace detail
+
+		/**
+		 * @brief Allocator which takes the single objects from a pool of fixed size blocks.
+		 * @details Made for the node based containers (list, single_list, linked_queue, linked_stack ...),
+		 *          which allocate one node each time. An allocator holds one pool for each size of the single
+		 *          objects allocated, which are created by its first allocation. The arrays are forwarded to the
+		 *          global operator new.
+		 *
+		 *          The copies and the rebound copies share the pools of the source if it has already allocated,
+		 *          otherwise each of them creates its own ones later. The copy constructed containers always get
+		 *          an allocator with the fresh pools, see select_on_container_copy_construction.
+		 *
+		 *          Each block records the pool it came from, so any pool_allocator could give back the memory got
+		 *          from any other one, and all the pool_allocators compare equal. Hence the nodes could be spliced
+		 *          between the containers using the different allocators.
+		 *
+		 *          The pools are freed after the last allocator sharing them is released and the last block of them
+		 *          is given back. The pools are not synchronized, so the containers which exchange nodes, or whose
+		 *          allocators share the pools (by copy assignment, swap, or copying an allocator which has
+		 *          allocated), must not be used by more than one thread at the same time.
+		 *
+		 * @code
+		 *     kerbal::container::list<int, kerbal::memory::pool_allocator<int> > l;
+		 *     kerbal::container::linked_queue<int,
+		 *             kerbal::container::single_list<int, kerbal::memory::pool_allocator<int> > > q;
+		 * @endcode
+		 */
+		template <typename Tp>
+		class pool_allocator
+		{
+			public:
+				typedef Tp						value_type;
+				typedef Tp*						pointer;
+				typedef const Tp*				const_pointer;
+				typedef Tp&						reference;
+				typedef const Tp&				const_reference;
+				typedef std::size_t				size_type;
+				typedef std::ptrdiff_t			difference_type;
+
+				typedef kerbal::type_traits::false_type			propagate_on_container_copy_assignment;
+				typedef kerbal::type_traits::true_type			propagate_on_container_move_assignment;
+				typedef kerbal::type_traits::true_type			propagate_on_container_swap;
+				typedef kerbal::type_traits::true_type			is_always_equal;
+
+				template <typename Up>
+				struct rebind
+				{
+						typedef pool_allocator<Up> other;
+				};
+
+			private:
+				template <typename Up>
+				friend class pool_allocator;
+
+				kerbal::memory::detail::pool_allocator_state * k_state;
+				size_type k_blocks_per_slab;
+
+			public:
+				pool_allocator() KERBAL_NOEXCEPT :
+						k_state(NULL), k_blocks_per_slab(0)
+				{
+				}
+
+				/*
+				 * @param blocks_per_slab number of blocks got from the operator new each time, 0 for about 4 KiB
+				 */
+				explicit pool_allocator(size_type blocks_per_slab) KERBAL_NOEXCEPT :
+						k_state(NULL), k_blocks_per_slab(blocks_per_slab)
+				{
+				}
+
+				pool_allocator(const pool_allocator & src) KERBAL_NOEXCEPT :
+						k_state(src.k_state), k_blocks_per_slab(src.k_blocks_per_slab)
+				{
+					this->__retain();
+				}
+
+				template <typename Up>
+				pool_allocator(const pool_allocator<Up> & src) KERBAL_NOEXCEPT :
+						k_state(src.k_state), k_blocks_per_slab(src.k_blocks_per_slab)
+				{
+					this->__retain();
+				}
+
+				~pool_allocator() KERBAL_NOEXCEPT
+				{
+					this->__release();
+				}
+
+				pool_allocator& operator=(const pool_allocator & src) KERBAL_NOEXCEPT
+				{
+					if (this->k_state != src.k_state) {
+						this->__release();
+						this->k_state = src.k_state;
+						this->__retain();
+					}
+					this->k_blocks_per_slab = src.k_blocks_per_slab;
+					return *this;
+				}
+
+				/*
+				 * the copy of a container doesn't share the pools with the source, so that they could be used by
+				 * the different threads
+				 */
+				pool_allocator select_on_container_copy_construction() const KERBAL_NOEXCEPT
+				{
+					return pool_allocator(this->k_blocks_per_slab);
+				}
+
+				size_type max_size() const KERBAL_NOEXCEPT
+				{
+					return std::numeric_limits<size_type>::max() / sizeof(value_type);
+				}
+
+				pointer allocate(size_type n)
+				{
+					if (n == 1 && __pooled()) {
+						if (this->k_state == NULL) {
+							this->k_state = new kerbal::memory::detail::pool_allocator_state(this->k_blocks_per_slab);
+						}
+						return static_cast<pointer>(
+								this->k_state->pool_of(sizeof(value_type), KERBAL_ALIGNOF(value_type)).allocate());
+					}
+					if (n > this->max_size()) {
+						kerbal::utility::throw_this_exception_helper<std::bad_alloc>::throw_this_exception();
+					}
+					return static_cast<pointer>(::operator new(n * sizeof(value_type)));
+				}
+
+				/*
+				 * the block is given back to the pool it came from, which may be not shared with this allocator
+				 */
+				void deallocate(pointer p, size_type n) KERBAL_NOEXCEPT
+				{
+					if (n == 1 && __pooled()) {
+						kerbal::memory::detail::pool_allocator_pool * pool =
+								static_cast<kerbal::memory::detail::pool_allocator_pool *>(
+										kerbal::memory::detail::fixed_size_pool::owner_of(
+												static_cast<void*>(p), KERBAL_ALIGNOF(value_type)));
+						pool->deallocate(static_cast<void*>(p));
+						if (pool->state->ref_count == 0) {
+							kerbal::memory::detail::pool_allocator_state::collect(pool->state);
+						}
+						return;
+					}
+					::operator delete(static_cast<void*>(p));
+				}
+
+#		if __cplusplus < 201103L
+
+				template <typename Up>
+				void construct(Up * p, const Up & val)
+				{
+					::new (static_cast<void*>(p)) Up(val);
+				}
+
+				template <typename Up>
+				void destroy(Up * p)
+				{
+					p->~Up();
+				}
+
+#		endif
+
+				template <typename Up>
+				bool operator==(const pool_allocator<Up> &) const KERBAL_NOEXCEPT
+				{
+					return true;
+				}
+
+				template <typename Up>
+				bool operator!=(const pool_allocator<Up> &) const KERBAL_NOEXCEPT
+				{
+					return false;
+				}
+
+			private:
+				static bool __pooled() KERBAL_NOEXCEPT
+				{
+					return KERBAL_ALIGNOF(value_type) <= kerbal::memory::detail::fixed_size_pool::MAX_ALIGN;
+				}
+
+				void __retain() KERBAL_NOEXCEPT
+				{
+					if (this->k_state != NULL) {
+						++this->k_state->ref_count;
+					}
+				}
+
+				void __release() KERBAL_NOEXCEPT
+				{
+					if (this->k_state != NULL) {
+						--this->k_state->ref_count;
+						kerbal::memory::detail::pool_allocator_state::collect(this->k_state);
+					}
+					this->k_state = NULL;
+				}
+
+		};
+
+	} // namespace memory
+
+} // namespace kerbal
+
+#endif // KERBAL_MEMORY_POOL_ALLOCATOR_HPP
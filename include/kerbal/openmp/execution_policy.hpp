@@ -0,0 +1,40 @@
+/**
+ * @file       execution_policy.hpp
+ * @brief
+ * @date       2020-08-23
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_OPENMP_EXECUTION_POLICY_HPP
+#define KERBAL_OPENMP_EXECUTION_POLICY_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+
+namespace kerbal
+{
+
+	namespace openmp
+	{
+
+		/**
+		 * @brief Tag type used to select the openMP based overloads of the algorithms.
+		 */
+		struct parallel_policy
+		{
+		};
+
+#	if __cplusplus < 201103L
+		static const parallel_policy par = parallel_policy();
+#	else
+		constexpr const parallel_policy par = parallel_policy();
+#	endif
+
+	} // namespace openmp
+
+} // namespace kerbal
+
+#endif // KERBAL_OPENMP_EXECUTION_POLICY_HPP
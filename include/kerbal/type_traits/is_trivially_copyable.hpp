@@ -0,0 +1,79 @@
+/**
+ * @file       is_trivially_copyable.hpp
+ * @brief
+ * @date       2020-09-09
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
+#define KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
+
+#include <kerbal/type_traits/array_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#else
+#	include <kerbal/type_traits/fundamental_deduction.hpp>
+#	include <kerbal/type_traits/member_pointer_deduction.hpp>
+#	include <kerbal/type_traits/pointer_deduction.hpp>
+#endif
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		namespace detail
+		{
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp>
+			struct is_trivially_copyable_helper :
+					kerbal::type_traits::bool_constant<
+							std::is_trivially_copyable<Tp>::value
+					>
+			{
+			};
+
+#	else
+
+			/*
+			 * Before C++11 the class types can't be told, so only the scalar types are accepted.
+			 */
+			template <typename Tp>
+			struct is_trivially_copyable_helper:
+					kerbal::type_traits::bool_constant<
+							kerbal::type_traits::is_fundamental<Tp>::value ||
+							kerbal::type_traits::is_member_pointer<Tp>::value ||
+							kerbal::type_traits::is_pointer<Tp>::value
+					>
+			{
+			};
+
+#	endif
+
+		} // namespace detail
+
+		/**
+		 * Whether the objects of type Tp could be copied by memcpy.
+		 */
+		template <typename Tp>
+		struct is_trivially_copyable:
+				kerbal::type_traits::detail::is_trivially_copyable_helper<
+						typename kerbal::type_traits::remove_all_extents<Tp>::type
+				>
+		{
+		};
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+#endif // KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
@@ -0,0 +1,100 @@
+/**
+ * @file       is_trivially_relocatable.hpp
+ * @brief
+ * @date       2020-09-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+#define KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_copyable.hpp>
+
+#include <cstddef>
+#include <utility>
+
+#if __cplusplus >= 201103L
+#	include <memory>
+#endif
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		/**
+		 * Whether an object of type Tp could be relocated, that is, moved to another address and then
+		 * destroyed at the old one, by memcpy the bytes only and forgetting the old object.
+		 *
+		 * All the trivially copyable types are trivially relocatable. Most of the class types holding
+		 * resources by pointers (such as `unique_ptr` or `kerbal::container::vector`) are relocatable too,
+		 * and could be opted in by KERBAL_DECLARE_TRIVIALLY_RELOCATABLE or by the partial specialization.
+		 * Types pointing into themselves (for example `std::string` of libstdc++ with small string
+		 * optimization, or `kerbal::container::small_vector`) must not be opted in.
+		 */
+		template <typename Tp>
+		struct is_trivially_relocatable:
+				kerbal::type_traits::is_trivially_copyable<Tp>
+		{
+		};
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_relocatable<Tp[N]>:
+				kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename T1, typename T2>
+		struct is_trivially_relocatable<std::pair<T1, T2> >:
+				kerbal::type_traits::bool_constant<
+						kerbal::type_traits::is_trivially_relocatable<T1>::value &&
+						kerbal::type_traits::is_trivially_relocatable<T2>::value
+				>
+		{
+		};
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp>
+		struct is_trivially_relocatable<std::unique_ptr<Tp, std::default_delete<Tp> > >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+		template <typename Tp>
+		struct is_trivially_relocatable<std::shared_ptr<Tp> >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+#	endif
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+
+/**
+ * Declare the type Tp as trivially relocatable. Use it at the global namespace.
+ * The type with comma in its name should be given by a typedef.
+ */
+#define KERBAL_DECLARE_TRIVIALLY_RELOCATABLE(Tp) \
+namespace kerbal \
+{ \
+	namespace type_traits \
+	{ \
+		template <> \
+		struct is_trivially_relocatable<Tp>: \
+				kerbal::type_traits::true_type \
+		{ \
+		}; \
+	} \
+}
+
+#endif // KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
@@ -0,0 +1,49 @@
+/**
+ * @file       addressable_priority_queue_cxx98_check.cpp
+ * @brief
+ * @date       2020-09-04
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+/*
+ * Check that the emplace overloads of the addressable priority queues compile and work without variadic
+ * templates. Exits with 0 on success.
+ *
+ * build: g++ -std=c++98 -I include script/addressable_priority_queue_cxx98_check.cpp -o addressable_priority_queue_cxx98_check
+ */
+
+#include <kerbal/container/addressable_priority_queue.hpp>
+#include <kerbal/container/static_addressable_priority_queue.hpp>
+
+#include <cstdio>
+#include <utility>
+
+template <typename Queue>
+bool check_emplace(Queue & q)
+{
+	q.emplace();
+	q.emplace(3, 1);
+	typename Queue::handle_type h = q.emplace(std::make_pair(2, 5));
+	q.emplace(1, 2);
+
+	if (q.size() != 4 || q.top() != std::make_pair(3, 1)) {
+		return false;
+	}
+	q.erase(h);
+	q.pop();
+	return q.size() == 2 && q.top() == std::make_pair(1, 2);
+}
+
+int main()
+{
+	kerbal::container::addressable_priority_queue<std::pair<int, int> > q;
+	kerbal::container::static_addressable_priority_queue<std::pair<int, int>, 8> sq;
+
+	bool ok = check_emplace(q) && check_emplace(sq);
+	std::printf("%s\n", ok ? "ok" : "failed");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file       pool_allocator_benchmark.cpp
+ * @brief
+ * @date       2020-09-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+/*
+ * Benchmark of kerbal::memory::pool_allocator against std::allocator on the node based containers.
+ * One CSV line per run is written to stdout:
+ *
+ *     container,allocator,workload,n,ns_per_op
+ *
+ * ns_per_op is the best of several repetitions. The workloads are:
+ *
+ *     fill_drain   push n elements, then pop them all
+ *     steady       keep n elements queued, push one and pop one per operation
+ *     churn        push and pop at random, the size wanders in [0, 2n)
+ *
+ * build: g++ -std=c++11 -O2 -I include script/pool_allocator_benchmark.cpp -o pool_allocator_benchmark
+ * usage: pool_allocator_benchmark [max_n = 1000000] [ops = 10000000]
+ */
+
+#include <kerbal/container/linked_queue.hpp>
+#include <kerbal/container/linked_stack.hpp>
+#include <kerbal/container/list.hpp>
+#include <kerbal/container/single_list.hpp>
+#include <kerbal/memory/pool_allocator.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+template <typename Allocator>
+struct allocator_name;
+
+template <typename Tp>
+struct allocator_name<std::allocator<Tp> >
+{
+		static const char * name() { return "std::allocator"; }
+};
+
+template <typename Tp>
+struct allocator_name<kerbal::memory::pool_allocator<Tp> >
+{
+		static const char * name() { return "pool_allocator"; }
+};
+
+/*
+ * Uniform push / pop interface over the containers, all in the FIFO or the LIFO order they are used in practice.
+ */
+template <typename Allocator>
+struct list_adapter
+{
+		static const char * name() { return "list"; }
+		kerbal::container::list<std::int64_t, Allocator> c;
+		void push(std::int64_t v) { c.push_back(v); }
+		void pop() { c.pop_front(); }
+};
+
+template <typename Allocator>
+struct single_list_adapter
+{
+		static const char * name() { return "single_list"; }
+		kerbal::container::single_list<std::int64_t, Allocator> c;
+		void push(std::int64_t v) { c.push_back(v); }
+		void pop() { c.pop_front(); }
+};
+
+template <typename Allocator>
+struct linked_queue_adapter
+{
+		static const char * name() { return "linked_queue"; }
+		kerbal::container::linked_queue<std::int64_t, kerbal::container::single_list<std::int64_t, Allocator> > c;
+		void push(std::int64_t v) { c.push(v); }
+		void pop() { c.pop(); }
+};
+
+template <typename Allocator>
+struct linked_stack_adapter
+{
+		static const char * name() { return "linked_stack"; }
+		kerbal::container::linked_stack<std::int64_t, kerbal::container::single_list<std::int64_t, Allocator> > c;
+		void push(std::int64_t v) { c.push(v); }
+		void pop() { c.pop(); }
+};
+
+typedef std::chrono::steady_clock bench_clock;
+
+template <typename Adapter>
+double fill_drain(std::size_t n, std::mt19937_64 &)
+{
+	Adapter a;
+	bench_clock::time_point start = bench_clock::now();
+	for (std::size_t i = 0; i < n; ++i) {
+		a.push(static_cast<std::int64_t>(i));
+	}
+	for (std::size_t i = 0; i < n; ++i) {
+		a.pop();
+	}
+	bench_clock::time_point end = bench_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / (2 * n);
+}
+
+template <typename Adapter>
+double steady(std::size_t n, std::size_t ops, std::mt19937_64 &)
+{
+	Adapter a;
+	for (std::size_t i = 0; i < n; ++i) {
+		a.push(static_cast<std::int64_t>(i));
+	}
+	bench_clock::time_point start = bench_clock::now();
+	for (std::size_t i = 0; i < ops; ++i) {
+		a.push(static_cast<std::int64_t>(i));
+		a.pop();
+	}
+	bench_clock::time_point end = bench_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / (2 * ops);
+}
+
+template <typename Adapter>
+double churn(std::size_t n, std::size_t ops, std::mt19937_64 & eg)
+{
+	Adapter a;
+	std::size_t size = 0;
+	std::vector<bool> push(ops);
+	for (std::size_t i = 0; i < ops; ++i) {
+		push[i] = size == 0 || (size < 2 * n && eg() % 2 == 0);
+		size += push[i] ? 1 : -1;
+	}
+	bench_clock::time_point start = bench_clock::now();
+	for (std::size_t i = 0; i < ops; ++i) {
+		if (push[i]) {
+			a.push(static_cast<std::int64_t>(i));
+		} else {
+			a.pop();
+		}
+	}
+	bench_clock::time_point end = bench_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+template <template <typename> class Adapter, typename Allocator>
+void bench_allocator(std::size_t max_n, std::size_t ops, std::mt19937_64 & eg)
+{
+	typedef Adapter<Allocator> adapter;
+	const char * container = adapter::name();
+	const char * allocator = allocator_name<Allocator>::name();
+	const int reps = 5;
+
+	for (std::size_t n = 10; n <= max_n; n *= 10) {
+		double best = 0;
+		for (int r = 0; r < reps; ++r) {
+			double ns = fill_drain<adapter>(n, eg);
+			best = r == 0 || ns < best ? ns : best;
+		}
+		std::printf("%s,%s,fill_drain,%zu,%.3f\n", container, allocator, n, best);
+
+		for (int r = 0; r < reps; ++r) {
+			double ns = steady<adapter>(n, ops, eg);
+			best = r == 0 || ns < best ? ns : best;
+		}
+		std::printf("%s,%s,steady,%zu,%.3f\n", container, allocator, n, best);
+
+		for (int r = 0; r < reps; ++r) {
+			double ns = churn<adapter>(n, ops, eg);
+			best = r == 0 || ns < best ? ns : best;
+		}
+		std::printf("%s,%s,churn,%zu,%.3f\n", container, allocator, n, best);
+		std::fflush(stdout);
+	}
+}
+
+template <template <typename> class Adapter>
+void bench_container(std::size_t max_n, std::size_t ops, std::mt19937_64 & eg)
+{
+	bench_allocator<Adapter, std::allocator<std::int64_t> >(max_n, ops, eg);
+	bench_allocator<Adapter, kerbal::memory::pool_allocator<std::int64_t> >(max_n, ops, eg);
+}
+
+int main(int argc, char * argv[])
+{
+	std::size_t max_n = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 1000000;
+	std::size_t ops = argc > 2 ? std::strtoull(argv[2], NULL, 10) : 10000000;
+
+	std::mt19937_64 eg(20200910);
+
+	std::printf("container,allocator,workload,n,ns_per_op\n");
+	bench_container<list_adapter>(max_n, ops, eg);
+	bench_container<single_list_adapter>(max_n, ops, eg);
+	bench_container<linked_queue_adapter>(max_n, ops, eg);
+	bench_container<linked_stack_adapter>(max_n, ops, eg);
+
+	return 0;
+}
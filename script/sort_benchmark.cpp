@@ -0,0 +1,397 @@
+/**
+ * @file       sort_benchmark.cpp
+ * @brief
+ * @date       2020-09-05
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+/*
+ * Benchmark of every sort in kerbal/algorithm/sort against std::sort and std::stable_sort over
+ * element types x input distributions x sizes. One CSV line per run is written to stdout:
+ *
+ *     algorithm,type,distribution,n,ns_per_element,sorted
+ *
+ * ns_per_element is the best of several repetitions. The data is meant to tune the dispatch of
+ * kerbal::algorithm::sort (sort_overload_policy_helper).
+ *
+ * build: g++ -std=c++11 -O2 -I include script/sort_benchmark.cpp -o sort_benchmark
+ *        add -fopenmp to benchmark the parallel sorts as well (thread count by OMP_NUM_THREADS)
+ * usage: sort_benchmark [max_n = 1000000] [budget_ms = 200]
+ *
+ * The sizes are 1e2, 1e3, ..., up to max_n (pass 100000000 for the full matrix). The quadratic sorts
+ * are capped at 1e4. The repetitions of one case stop after budget_ms, and any sort whose one run
+ * exceeds budget_ms is skipped for the larger sizes of the same type and distribution.
+ */
+
+#include <kerbal/algorithm/sort/bubble_sort.hpp>
+#include <kerbal/algorithm/sort/heap_sort.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/algorithm/sort/intro_sort.hpp>
+#include <kerbal/algorithm/sort/merge_sort.hpp>
+#include <kerbal/algorithm/sort/msd_radix_sort.hpp>
+#include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
+#include <kerbal/algorithm/sort/quick_sort.hpp>
+#include <kerbal/algorithm/sort/radix_sort.hpp>
+#include <kerbal/algorithm/sort/selection_sort.hpp>
+#include <kerbal/algorithm/sort/shell_sort.hpp>
+#include <kerbal/algorithm/sort/sort.hpp>
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/algorithm/sort/tim_sort.hpp>
+
+#if defined(_OPENMP)
+#	include <kerbal/algorithm/sort/parallel_intro_sort.hpp>
+#	include <kerbal/algorithm/sort/parallel_pigeonhole_sort.hpp>
+#	include <kerbal/algorithm/sort/parallel_radix_sort.hpp>
+#	include <kerbal/algorithm/sort/parallel_sort.hpp>
+#	include <kerbal/algorithm/sort/parallel_stable_sort.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct record64
+{
+		std::int64_t key;
+		char payload[56];
+
+		friend bool operator<(const record64 & lhs, const record64 & rhs)
+		{
+			return lhs.key < rhs.key;
+		}
+};
+
+static_assert(sizeof(record64) == 64, "record64 should be 64 bytes");
+
+struct record64_key
+{
+		typedef std::int64_t result_type;
+
+		std::int64_t operator()(const record64 & r) const
+		{
+			return r.key;
+		}
+};
+
+/*
+ * The generators produce keys in [0, 2^62), these map them to the element types monotonically,
+ * so that sorted keys give sorted elements and the values spread over the whole range of the type.
+ */
+template <typename Tp>
+struct value_maker;
+
+template <>
+struct value_maker<std::int16_t>
+{
+		static const char * name() { return "int16"; }
+		static std::int16_t make(std::uint64_t key) { return static_cast<std::int16_t>(static_cast<std::int64_t>(key >> 46) - 32768); }
+};
+
+template <>
+struct value_maker<std::int32_t>
+{
+		static const char * name() { return "int32"; }
+		static std::int32_t make(std::uint64_t key) { return static_cast<std::int32_t>(static_cast<std::int64_t>(key >> 30) - (1LL << 31)); }
+};
+
+template <>
+struct value_maker<std::int64_t>
+{
+		static const char * name() { return "int64"; }
+		static std::int64_t make(std::uint64_t key) { return static_cast<std::int64_t>(key) - (1LL << 61); }
+};
+
+template <>
+struct value_maker<double>
+{
+		static const char * name() { return "double"; }
+		static double make(std::uint64_t key) { return static_cast<double>(static_cast<std::int64_t>(key) - (1LL << 61)) / (1LL << 40); }
+};
+
+template <>
+struct value_maker<record64>
+{
+		static const char * name() { return "record64"; }
+		static record64 make(std::uint64_t key)
+		{
+			record64 r;
+			r.key = static_cast<std::int64_t>(key) - (1LL << 61);
+			for (std::size_t i = 0; i < sizeof(r.payload); ++i) {
+				r.payload[i] = static_cast<char>(key >> (i % 8 * 8));
+			}
+			return r;
+		}
+};
+
+enum distribution
+{
+	RANDOM, SORTED, REVERSED, ORGAN_PIPE, FEW_UNIQUE, NEARLY_SORTED
+};
+
+const char * distribution_name[] = {
+	"random", "sorted", "reversed", "organ_pipe", "few_unique", "nearly_sorted"
+};
+
+std::vector<std::uint64_t> make_keys(distribution dist, std::size_t n, std::mt19937_64 & eg)
+{
+	const std::uint64_t range = 1ULL << 62;
+	const std::uint64_t step = range / n;
+	std::vector<std::uint64_t> keys(n);
+	switch (dist) {
+		case RANDOM: {
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = eg() % range;
+			}
+			break;
+		}
+		case SORTED: {
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = i * step;
+			}
+			break;
+		}
+		case REVERSED: {
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = (n - 1 - i) * step;
+			}
+			break;
+		}
+		case ORGAN_PIPE: {
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = (i < n / 2 ? i : n - 1 - i) * step;
+			}
+			break;
+		}
+		case FEW_UNIQUE: {
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = eg() % 16 * (range / 16);
+			}
+			break;
+		}
+		case NEARLY_SORTED: { // 1% of the elements are swapped with random ones
+			for (std::size_t i = 0; i < n; ++i) {
+				keys[i] = i * step;
+			}
+			for (std::size_t k = 0; k < n / 100 + 1; ++k) {
+				std::swap(keys[eg() % n], keys[eg() % n]);
+			}
+			break;
+		}
+	}
+	return keys;
+}
+
+template <typename Tp>
+struct algorithm_entry
+{
+		const char * name;
+		std::size_t max_n;
+		void (*run)(Tp *, Tp *);
+};
+
+const std::size_t QUADRATIC_MAX_N = 10000;
+const std::size_t UNLIMITED = static_cast<std::size_t>(-1);
+
+template <typename Tp> void run_std_sort(Tp * first, Tp * last) { std::sort(first, last); }
+template <typename Tp> void run_std_stable_sort(Tp * first, Tp * last) { std::stable_sort(first, last); }
+template <typename Tp> void run_sort(Tp * first, Tp * last) { kerbal::algorithm::sort(first, last); }
+template <typename Tp> void run_intro_sort(Tp * first, Tp * last) { kerbal::algorithm::intro_sort(first, last); }
+template <typename Tp> void run_nonrecursive_intro_sort(Tp * first, Tp * last) { kerbal::algorithm::nonrecursive_intro_sort(first, last); }
+template <typename Tp> void run_pdq_intro_sort(Tp * first, Tp * last) { kerbal::algorithm::pdq_intro_sort(first, last); }
+template <typename Tp> void run_quick_sort(Tp * first, Tp * last) { kerbal::algorithm::quick_sort(first, last); }
+template <typename Tp> void run_nonrecursive_qsort(Tp * first, Tp * last) { kerbal::algorithm::nonrecursive_qsort(first, last); }
+template <typename Tp> void run_heap_sort(Tp * first, Tp * last) { kerbal::algorithm::heap_sort(first, last); }
+template <typename Tp> void run_merge_sort(Tp * first, Tp * last) { kerbal::algorithm::merge_sort(first, last); }
+template <typename Tp> void run_stable_sort(Tp * first, Tp * last) { kerbal::algorithm::stable_sort(first, last); }
+template <typename Tp> void run_tim_sort(Tp * first, Tp * last) { kerbal::algorithm::tim_sort(first, last); }
+template <typename Tp> void run_shell_sort(Tp * first, Tp * last) { kerbal::algorithm::shell_sort(first, last); }
+template <typename Tp> void run_insertion_sort(Tp * first, Tp * last) { kerbal::algorithm::insertion_sort(first, last); }
+template <typename Tp> void run_directly_insertion_sort(Tp * first, Tp * last) { kerbal::algorithm::directly_insertion_sort(first, last); }
+template <typename Tp> void run_selection_sort(Tp * first, Tp * last) { kerbal::algorithm::selection_sort(first, last); }
+template <typename Tp> void run_bubble_sort(Tp * first, Tp * last) { kerbal::algorithm::bubble_sort(first, last); }
+template <typename Tp> void run_flag_bubble_sort(Tp * first, Tp * last) { kerbal::algorithm::flag_bubble_sort(first, last); }
+template <typename Tp> void run_radix_sort(Tp * first, Tp * last) { kerbal::algorithm::radix_sort(first, last); }
+template <typename Tp> void run_msd_radix_sort(Tp * first, Tp * last) { kerbal::algorithm::msd_radix_sort(first, last); }
+template <typename Tp> void run_pigeonhole_sort(Tp * first, Tp * last) { kerbal::algorithm::pigeonhole_sort(first, last); }
+
+void run_radix_sort_by_key(record64 * first, record64 * last) { kerbal::algorithm::radix_sort_by_key(first, last, record64_key()); }
+void run_msd_radix_sort_by_key(record64 * first, record64 * last) { kerbal::algorithm::msd_radix_sort_by_key(first, last, record64_key()); }
+
+#if defined(_OPENMP)
+template <typename Tp> void run_parallel_sort(Tp * first, Tp * last) { kerbal::algorithm::sort(kerbal::openmp::par, first, last); }
+template <typename Tp> void run_parallel_intro_sort(Tp * first, Tp * last) { kerbal::algorithm::parallel_intro_sort(first, last); }
+template <typename Tp> void run_parallel_stable_sort(Tp * first, Tp * last) { kerbal::algorithm::parallel_stable_sort(first, last); }
+template <typename Tp> void run_parallel_radix_sort(Tp * first, Tp * last) { kerbal::algorithm::parallel_radix_sort(first, last); }
+template <typename Tp> void run_parallel_pigeonhole_sort(Tp * first, Tp * last) { kerbal::algorithm::parallel_pigeonhole_sort(first, last); }
+
+void run_parallel_radix_sort_by_key(record64 * first, record64 * last) { kerbal::algorithm::parallel_radix_sort_by_key(first, last, record64_key()); }
+#endif
+
+template <typename Tp>
+void add_radix_sorts(std::vector<algorithm_entry<Tp> > & algos, std::true_type)
+{
+	algos.push_back(algorithm_entry<Tp>{"radix_sort", UNLIMITED, run_radix_sort<Tp>});
+	algos.push_back(algorithm_entry<Tp>{"msd_radix_sort", UNLIMITED, run_msd_radix_sort<Tp>});
+#if defined(_OPENMP)
+	algos.push_back(algorithm_entry<Tp>{"parallel_radix_sort", UNLIMITED, run_parallel_radix_sort<Tp>});
+#endif
+}
+
+template <typename Tp>
+void add_radix_sorts(std::vector<algorithm_entry<Tp> > &, std::false_type)
+{
+}
+
+void add_radix_sorts(std::vector<algorithm_entry<record64> > & algos, std::false_type)
+{
+	algos.push_back(algorithm_entry<record64>{"radix_sort_by_key", UNLIMITED, run_radix_sort_by_key});
+	algos.push_back(algorithm_entry<record64>{"msd_radix_sort_by_key", UNLIMITED, run_msd_radix_sort_by_key});
+#if defined(_OPENMP)
+	algos.push_back(algorithm_entry<record64>{"parallel_radix_sort_by_key", UNLIMITED, run_parallel_radix_sort_by_key});
+#endif
+}
+
+template <typename Tp>
+void add_pigeonhole_sort(std::vector<algorithm_entry<Tp> > & algos, std::true_type)
+{
+	algos.push_back(algorithm_entry<Tp>{"pigeonhole_sort", UNLIMITED, run_pigeonhole_sort<Tp>});
+#if defined(_OPENMP)
+	algos.push_back(algorithm_entry<Tp>{"parallel_pigeonhole_sort", UNLIMITED, run_parallel_pigeonhole_sort<Tp>});
+#endif
+}
+
+template <typename Tp>
+void add_pigeonhole_sort(std::vector<algorithm_entry<Tp> > &, std::false_type)
+{
+}
+
+template <typename Tp>
+std::vector<algorithm_entry<Tp> > algorithms()
+{
+	std::vector<algorithm_entry<Tp> > algos = {
+		{"std::sort", UNLIMITED, run_std_sort<Tp>},
+		{"std::stable_sort", UNLIMITED, run_std_stable_sort<Tp>},
+		{"sort", UNLIMITED, run_sort<Tp>},
+		{"intro_sort", UNLIMITED, run_intro_sort<Tp>},
+		{"nonrecursive_intro_sort", UNLIMITED, run_nonrecursive_intro_sort<Tp>},
+		{"pdq_intro_sort", UNLIMITED, run_pdq_intro_sort<Tp>},
+		{"quick_sort", UNLIMITED, run_quick_sort<Tp>},
+		{"nonrecursive_qsort", UNLIMITED, run_nonrecursive_qsort<Tp>},
+		{"heap_sort", UNLIMITED, run_heap_sort<Tp>},
+		{"merge_sort", UNLIMITED, run_merge_sort<Tp>},
+		{"stable_sort", UNLIMITED, run_stable_sort<Tp>},
+		{"tim_sort", UNLIMITED, run_tim_sort<Tp>},
+		{"shell_sort", UNLIMITED, run_shell_sort<Tp>},
+		{"insertion_sort", QUADRATIC_MAX_N, run_insertion_sort<Tp>},
+		{"directly_insertion_sort", QUADRATIC_MAX_N, run_directly_insertion_sort<Tp>},
+		{"selection_sort", QUADRATIC_MAX_N, run_selection_sort<Tp>},
+		{"bubble_sort", QUADRATIC_MAX_N, run_bubble_sort<Tp>},
+		{"flag_bubble_sort", QUADRATIC_MAX_N, run_flag_bubble_sort<Tp>},
+#if defined(_OPENMP)
+		{"sort(par)", UNLIMITED, run_parallel_sort<Tp>},
+		{"parallel_intro_sort", UNLIMITED, run_parallel_intro_sort<Tp>},
+		{"parallel_stable_sort", UNLIMITED, run_parallel_stable_sort<Tp>},
+#endif
+	};
+	add_radix_sorts(algos, std::integral_constant<bool,
+			kerbal::algorithm::is_radix_sort_acceptable_type<Tp>::value>());
+	add_pigeonhole_sort(algos, std::integral_constant<bool,
+			kerbal::algorithm::is_pigeonhole_sort_acceptable_type<Tp>::value>());
+	return algos;
+}
+
+template <typename Tp>
+bool is_sorted_by_key(const std::vector<Tp> & v)
+{
+	for (std::size_t i = 1; i < v.size(); ++i) {
+		if (v[i] < v[i - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename Tp>
+void bench_type(std::size_t max_n, double budget_ns, std::mt19937_64 & eg)
+{
+	typedef std::chrono::steady_clock clock;
+
+	std::vector<algorithm_entry<Tp> > algos(algorithms<Tp>());
+
+	for (int dist = RANDOM; dist <= NEARLY_SORTED; ++dist) {
+		std::vector<bool> too_slow(algos.size(), false);
+		for (std::size_t n = 100; n <= max_n; n *= 10) {
+			std::vector<std::uint64_t> keys(make_keys(static_cast<distribution>(dist), n, eg));
+			std::vector<Tp> input(n);
+			for (std::size_t i = 0; i < n; ++i) {
+				input[i] = value_maker<Tp>::make(keys[i]);
+			}
+			keys.clear();
+			keys.shrink_to_fit();
+
+			std::vector<Tp> data;
+			for (std::size_t a = 0; a < algos.size(); ++a) {
+				const algorithm_entry<Tp> & algo = algos[a];
+				if (n > algo.max_n || too_slow[a]) {
+					continue;
+				}
+
+				// repeat until about 1e7 elements are sorted, or the budget is used up
+				std::size_t reps = std::max<std::size_t>(1, std::min<std::size_t>(1000, 10000000 / n));
+				double best = 0;
+				double total = 0;
+				bool sorted = true;
+				for (std::size_t r = 0; r < reps && total < budget_ns; ++r) {
+					data = input;
+					clock::time_point start = clock::now();
+					algo.run(data.data(), data.data() + n);
+					clock::time_point end = clock::now();
+					double ns = std::chrono::duration<double, std::nano>(end - start).count();
+					total += ns;
+					if (r == 0 || ns < best) {
+						best = ns;
+					}
+					if (r == 0) {
+						sorted = is_sorted_by_key(data);
+					}
+					if (ns > budget_ns) {
+						too_slow[a] = true;
+						break;
+					}
+				}
+
+				std::printf("%s,%s,%s,%zu,%.3f,%d\n", algo.name, value_maker<Tp>::name(), distribution_name[dist],
+							n, best / n, sorted ? 1 : 0);
+				std::fflush(stdout);
+			}
+		}
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	std::size_t max_n = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 1000000;
+	double budget_ms = argc > 2 ? std::strtod(argv[2], NULL) : 200;
+	double budget_ns = budget_ms * 1e6;
+
+	std::mt19937_64 eg(20200905);
+
+	std::printf("algorithm,type,distribution,n,ns_per_element,sorted\n");
+	bench_type<std::int16_t>(max_n, budget_ns, eg);
+	bench_type<std::int32_t>(max_n, budget_ns, eg);
+	bench_type<std::int64_t>(max_n, budget_ns, eg);
+	bench_type<double>(max_n, budget_ns, eg);
+	bench_type<record64>(max_n, budget_ns, eg);
+
+	return 0;
+}